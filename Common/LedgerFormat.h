@@ -0,0 +1,110 @@
+/**
+ * Name: Backgrounder
+ * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
+ * Description: allow applications to run in the background
+ * Author: Lance Fetters (aka. ashikase)
+ * Last-modified: 2026-10-17 10:12:45
+ */
+
+/**
+ * Copyright (C) 2008-2010  Lance Fetters (aka. ashikase)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef BG_LEDGERFORMAT_H
+#define BG_LEDGERFORMAT_H
+
+#include <stdint.h>
+
+// On-disk format of the lifecycle ledger
+// NOTE: The log is a sequence of blocks, each starting with a magic value.
+//       A session block is written each time SpringBoard starts; app IDs and
+//       timestamps are only meaningful within the session in which they
+//       were recorded.
+// NOTE: All values are stored in host byte order (little-endian).
+
+#define BG_LEDGER_FILE_PATH     "/var/mobile/Library/Logs/jp.ashikase.backgrounder.ledger"
+
+#define BG_LEDGER_VERSION       1
+#define BG_LEDGER_MAGIC_SESSION 0x53474c42 // "BLGS"
+#define BG_LEDGER_MAGIC_CHUNK   0x43474c42 // "BLGC"
+
+typedef enum {
+    BGLedgerEventLaunch = 0,      // arg: 1 if resumed from background
+    BGLedgerEventDeactivate,      // arg: 1 if backgrounding enabled
+    BGLedgerEventExit,
+    BGLedgerEventExitAbnormally,
+    BGLedgerEventSetBackgrounding, // arg: 1 if enabled
+    BGLedgerEventWatchdogTimer,    // arg: timer type, 0x100 set if suppressed
+    BGLedgerEventRelaunch,
+    BGLedgerEventToggleLatency     // arg: milliseconds from invocation to suspension
+} BGLedgerEventType;
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    // Conversion of timestamps to nanoseconds (numer / denom)
+    uint32_t timebaseNumer;
+    uint32_t timebaseDenom;
+    // Wall-clock time (seconds since 1970) and timestamp at session start
+    uint64_t startTime;
+    uint64_t startTimestamp;
+} BGLedgerSessionHeader;
+
+// NOTE: The chunk header is followed by nameCount name entries, then by
+//       eventCount events. Names are only written for app IDs that have not
+//       yet been named in the current session.
+typedef struct {
+    uint32_t magic;
+    uint32_t nameCount;
+    uint32_t eventCount;
+    // Number of events lost due to ring buffer overflow since the last chunk
+    uint32_t droppedCount;
+} BGLedgerChunkHeader;
+
+// NOTE: Followed by length bytes of UTF-8 display identifier (no terminator)
+typedef struct {
+    uint32_t appId;
+    uint32_t length;
+} BGLedgerNameEntry;
+
+typedef struct {
+    uint64_t timestamp;
+    uint32_t appId;
+    uint16_t type;
+    uint16_t arg;
+} BGLedgerEvent;
+
+#endif // BG_LEDGERFORMAT_H
+
+/* vim: set filetype=objcpp sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */
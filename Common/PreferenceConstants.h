@@ -3,7 +3,7 @@
  * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
  * Description: allow applications to run in the background
  * Author: Lance Fetters (aka. ashikase)
- * Last-modified: 2010-08-06 00:58:31
+ * Last-modified: 2026-10-17 22:58:23
  */
 
 /**
@@ -46,7 +46,10 @@ typedef enum {
     BGBackgroundingMethodOff = 0,
     BGBackgroundingMethodNative,
     BGBackgroundingMethodBackgrounder,
-    BGBackgroundingMethodAutoDetect
+    BGBackgroundingMethodAutoDetect,
+    // NOTE: Same as Backgrounder, but stopped and resumed on a duty cycle
+    //       while in the background.
+    BGBackgroundingMethodThrottled
 } BGBackgroundingMethod;
 
 
@@ -58,16 +61,33 @@ typedef enum {
 #define kGlobal                  @"global"
 #define kOverrides               @"overrides"
 
+// NOTE: Applies to all apps; zero means no limit
+#define kMaxBackgroundedApps     @"maxBackgroundedApps"
+
 #define kBackgroundingMethod     @"backgroundingMethod"
 #define kBadgeEnabled            @"badgeEnabled"
 #define kStatusBarIconEnabled    @"statusBarIconEnabled"
 #define kPersistent              @"persistent"
 #define kEnableAtLaunch          @"enableAtLaunch"
 #define kMinimizeOnToggle        @"minimizeOnToggle"
+#define kSuspendImmediately      @"suspendImmediately"
+#define kFeedbackDuration        @"feedbackDuration"
 #define kFallbackToNative        @"fallbackToNative"
 #define kFastAppSwitchingEnabled @"fastAppSwitchingEnabled"
 #define kForceFastAppSwitching   @"forceFastAppSwitching"
 
+// NOTE: Only used with "Throttled" method; values are in seconds
+#define kThrottleRunDuration     @"throttleRunDuration"
+#define kThrottlePeriod          @"throttlePeriod"
+
+// NOTE: Only used with "Backgrounder" method; value is in minutes, zero means
+//       never time out
+#define kIdleTimeout             @"idleTimeout"
+
+// NOTE: Only used with "Native" method or "Fall Back"; value is in seconds,
+//       zero means no limit
+#define kBackgroundTaskBudget    @"backgroundTaskBudget"
+
 
 // Former preference settings keys
 
@@ -0,0 +1,86 @@
+/**
+ * Name: Backgrounder
+ * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
+ * Description: allow applications to run in the background
+ * Author: Lance Fetters (aka. ashikase)
+ * Last-modified: 2026-10-17 22:46:20
+ */
+
+/**
+ * Copyright (C) 2008-2010  Lance Fetters (aka. ashikase)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <Foundation/Foundation.h>
+
+#include "PolicyEngine.h"
+
+// Per-application state flags
+typedef enum {
+    BGAppStateExitsOnSuspend       = 1 << 0,
+    BGAppStateSupportsMultitask    = 1 << 1,
+    BGAppStateBackgroundingEnabled = 1 << 2,
+    BGAppStatePermittedToRelaunch  = 1 << 3,
+    BGAppStateHasBackgroundModes   = 1 << 4
+} BGAppState;
+
+// Small integer ID assigned to a display identifier on first use
+typedef unsigned int BGAppID;
+#define BGAppIDNotFound ((BGAppID)-1)
+
+// NOTE: These functions are not thread-safe; only call from the main thread.
+
+BGAppID internDisplayIdentifier(NSString *displayId);
+BGAppID appIdForDisplayIdentifier(NSString *displayId);
+NSString *displayIdentifierForAppId(BGAppID appId);
+NSUInteger appCount();
+
+BOOL appIdHasState(BGAppID appId, BGAppState state);
+void setAppIdState(BGAppID appId, BGAppState state, BOOL value);
+
+BOOL appHasState(NSString *displayId, BGAppState state);
+void setAppState(NSString *displayId, BGAppState state, BOOL value);
+
+// NOTE: Lifecycle state as tracked by the policy engine; apps not yet known
+//       are not running.
+BGPolicyState appIdPolicyState(BGAppID appId);
+void setAppIdPolicyState(BGAppID appId, BGPolicyState state);
+
+// NOTE: The recency list orders apps by last use (most recent first);
+//       all operations are O(1).
+void moveAppIdToFront(BGAppID appId);
+void removeAppIdFromRecencyList(BGAppID appId);
+BOOL isAppIdInRecencyList(BGAppID appId);
+BGAppID leastRecentAppId();
+NSUInteger recencyListCount();
+
+/* vim: set filetype=objcpp sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */
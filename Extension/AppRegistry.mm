@@ -0,0 +1,236 @@
+/**
+ * Name: Backgrounder
+ * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
+ * Description: allow applications to run in the background
+ * Author: Lance Fetters (aka. ashikase)
+ * Last-modified: 2026-10-17 22:46:20
+ */
+
+/**
+ * Copyright (C) 2008-2010  Lance Fetters (aka. ashikase)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "AppRegistry.h"
+
+#import <CoreFoundation/CoreFoundation.h>
+
+// Map of display identifier to app ID
+// NOTE: Values are stored directly as integers (not CF objects).
+static CFMutableDictionaryRef appIds_ = NULL;
+
+// List of display identifiers, indexed by app ID
+static CFMutableArrayRef displayIds_ = NULL;
+
+// State flags, indexed by app ID
+static uint8_t *states_ = NULL;
+static CFIndex statesCapacity_ = 0;
+
+// Lifecycle states, indexed by app ID
+// NOTE: Shares the capacity of the state table.
+static uint8_t *policyStates_ = NULL;
+
+// Doubly-linked recency list, indexed by app ID (most recent at head)
+// NOTE: Arrays share the capacity of the state table.
+static BGAppID *recencyPrev_ = NULL;
+static BGAppID *recencyNext_ = NULL;
+static BGAppID recencyHead_ = BGAppIDNotFound;
+static BGAppID recencyTail_ = BGAppIDNotFound;
+static NSUInteger recencyCount_ = 0;
+
+// NOTE: Internal flag; not part of BGAppState
+#define kInRecencyList (1 << 7)
+
+//==============================================================================
+
+BGAppID internDisplayIdentifier(NSString *displayId)
+{
+    if (displayId == nil)
+        return BGAppIDNotFound;
+
+    if (appIds_ == NULL) {
+        appIds_ = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, &kCFTypeDictionaryKeyCallBacks, NULL);
+        displayIds_ = CFArrayCreateMutable(kCFAllocatorDefault, 0, &kCFTypeArrayCallBacks);
+    }
+
+    const void *value = NULL;
+    if (CFDictionaryGetValueIfPresent(appIds_, displayId, &value))
+        return (BGAppID)(uintptr_t)value;
+
+    // Not yet interned; assign the next available ID
+    CFIndex count = CFArrayGetCount(displayIds_);
+    if (count == statesCapacity_) {
+        // Grow the state table
+        CFIndex capacity = (statesCapacity_ == 0) ? 256 : (statesCapacity_ * 2);
+        states_ = (uint8_t *)realloc(states_, capacity * sizeof(uint8_t));
+        memset(states_ + statesCapacity_, 0, (capacity - statesCapacity_) * sizeof(uint8_t));
+        policyStates_ = (uint8_t *)realloc(policyStates_, capacity * sizeof(uint8_t));
+        memset(policyStates_ + statesCapacity_, BGPolicyStateNotRunning, (capacity - statesCapacity_) * sizeof(uint8_t));
+        recencyPrev_ = (BGAppID *)realloc(recencyPrev_, capacity * sizeof(BGAppID));
+        recencyNext_ = (BGAppID *)realloc(recencyNext_, capacity * sizeof(BGAppID));
+        statesCapacity_ = capacity;
+    }
+
+    // NOTE: Store a copy, as the passed string may be mutable
+    NSString *key = [displayId copy];
+    CFArrayAppendValue(displayIds_, key);
+    CFDictionarySetValue(appIds_, key, (const void *)(uintptr_t)count);
+    [key release];
+
+    return (BGAppID)count;
+}
+
+BGAppID appIdForDisplayIdentifier(NSString *displayId)
+{
+    const void *value = NULL;
+    if (displayId != nil && appIds_ != NULL && CFDictionaryGetValueIfPresent(appIds_, displayId, &value))
+        return (BGAppID)(uintptr_t)value;
+    return BGAppIDNotFound;
+}
+
+NSString *displayIdentifierForAppId(BGAppID appId)
+{
+    return (appId < appCount()) ? (NSString *)CFArrayGetValueAtIndex(displayIds_, appId) : nil;
+}
+
+NSUInteger appCount()
+{
+    return (displayIds_ != NULL) ? CFArrayGetCount(displayIds_) : 0;
+}
+
+//==============================================================================
+
+BOOL appIdHasState(BGAppID appId, BGAppState state)
+{
+    return (appId < appCount()) ? ((states_[appId] & state) != 0) : NO;
+}
+
+void setAppIdState(BGAppID appId, BGAppState state, BOOL value)
+{
+    if (appId < appCount()) {
+        if (value)
+            states_[appId] |= state;
+        else
+            states_[appId] &= ~state;
+    }
+}
+
+BOOL appHasState(NSString *displayId, BGAppState state)
+{
+    // NOTE: Unknown apps have no state set; do not intern them
+    return appIdHasState(appIdForDisplayIdentifier(displayId), state);
+}
+
+void setAppState(NSString *displayId, BGAppState state, BOOL value)
+{
+    BGAppID appId = value ? internDisplayIdentifier(displayId) : appIdForDisplayIdentifier(displayId);
+    setAppIdState(appId, state, value);
+}
+
+//==============================================================================
+
+BGPolicyState appIdPolicyState(BGAppID appId)
+{
+    return (appId < appCount()) ? (BGPolicyState)policyStates_[appId] : BGPolicyStateNotRunning;
+}
+
+void setAppIdPolicyState(BGAppID appId, BGPolicyState state)
+{
+    if (appId < appCount())
+        policyStates_[appId] = state;
+}
+
+//==============================================================================
+
+static void unlinkAppId(BGAppID appId)
+{
+    BGAppID prev = recencyPrev_[appId];
+    BGAppID next = recencyNext_[appId];
+    if (prev != BGAppIDNotFound)
+        recencyNext_[prev] = next;
+    else
+        recencyHead_ = next;
+    if (next != BGAppIDNotFound)
+        recencyPrev_[next] = prev;
+    else
+        recencyTail_ = prev;
+}
+
+void moveAppIdToFront(BGAppID appId)
+{
+    if (appId >= appCount())
+        return;
+
+    if ((states_[appId] & kInRecencyList) != 0) {
+        if (appId == recencyHead_)
+            return;
+        unlinkAppId(appId);
+    } else {
+        states_[appId] |= kInRecencyList;
+        ++recencyCount_;
+    }
+
+    // Insert at head
+    recencyPrev_[appId] = BGAppIDNotFound;
+    recencyNext_[appId] = recencyHead_;
+    if (recencyHead_ != BGAppIDNotFound)
+        recencyPrev_[recencyHead_] = appId;
+    recencyHead_ = appId;
+    if (recencyTail_ == BGAppIDNotFound)
+        recencyTail_ = appId;
+}
+
+void removeAppIdFromRecencyList(BGAppID appId)
+{
+    if (appId < appCount() && (states_[appId] & kInRecencyList) != 0) {
+        unlinkAppId(appId);
+        states_[appId] &= ~kInRecencyList;
+        --recencyCount_;
+    }
+}
+
+BOOL isAppIdInRecencyList(BGAppID appId)
+{
+    return (appId < appCount()) ? ((states_[appId] & kInRecencyList) != 0) : NO;
+}
+
+BGAppID leastRecentAppId()
+{
+    return recencyTail_;
+}
+
+NSUInteger recencyListCount()
+{
+    return recencyCount_;
+}
+
+/* vim: set filetype=objcpp sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */
@@ -79,6 +79,7 @@
         [event.name isEqualToString:LAEventNameLockHoldShort]);
 
     // Invoke Backgrounder
+    markBackgrounderInvocationTime();
     SpringBoard *springBoard = (SpringBoard *)[UIApplication sharedApplication];
     [springBoard invokeBackgrounderAndAutoSuspend:autoSuspend];
  
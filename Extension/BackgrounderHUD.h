@@ -0,0 +1,63 @@
+/**
+ * Name: Backgrounder
+ * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
+ * Description: allow applications to run in the background
+ * Author: Lance Fetters (aka. ashikase)
+ * Last-modified: 2026-10-17 10:12:45
+ */
+
+/**
+ * Copyright (C) 2008-2010  Lance Fetters (aka. ashikase)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <UIKit/UIKit.h>
+
+// Non-modal overlay used to display the result of a backgrounding toggle
+// NOTE: The overlay is created once and reused; it does not receive touches
+//       and does not go through SpringBoard's alert queue.
+@interface BackgrounderHUD : NSObject
+{
+    UIWindow *window_;
+    UIView *contentView_;
+    UILabel *label_;
+}
+@property(nonatomic, readonly, getter=isVisible) BOOL visible;
+
++ (BackgrounderHUD *)sharedInstance;
+- (void)showWithTitle:(NSString *)title;
+- (void)setTitle:(NSString *)title;
+- (void)hide;
+
+@end
+
+/* vim: set filetype=objcpp sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */
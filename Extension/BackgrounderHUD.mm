@@ -0,0 +1,163 @@
+/**
+ * Name: Backgrounder
+ * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
+ * Description: allow applications to run in the background
+ * Author: Lance Fetters (aka. ashikase)
+ * Last-modified: 2026-10-17 10:12:45
+ */
+
+/**
+ * Copyright (C) 2008-2010  Lance Fetters (aka. ashikase)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "BackgrounderHUD.h"
+
+#import <QuartzCore/QuartzCore.h>
+
+#import "Headers.h"
+
+#define kHUDSize 160.0f
+#define kHUDFadeDuration 0.2f
+
+@implementation BackgrounderHUD
+
++ (BackgrounderHUD *)sharedInstance
+{
+    static BackgrounderHUD *instance = nil;
+    if (instance == nil)
+        instance = [[BackgrounderHUD alloc] init];
+    return instance;
+}
+
+- (id)init
+{
+    self = [super init];
+    if (self) {
+        CGRect screenBounds = [[UIScreen mainScreen] bounds];
+
+        // NOTE: Window covers the screen so that the content can be rotated
+        //       about its center to match the orientation of the front app.
+        window_ = [[UIWindow alloc] initWithFrame:screenBounds];
+        window_.windowLevel = UIWindowLevelAlert + 1.0f;
+        window_.backgroundColor = [UIColor clearColor];
+        window_.userInteractionEnabled = NO;
+        window_.hidden = YES;
+
+        contentView_ = [[UIView alloc] initWithFrame:CGRectMake(0, 0, kHUDSize, kHUDSize)];
+        contentView_.center = CGPointMake(CGRectGetMidX(screenBounds), CGRectGetMidY(screenBounds));
+        contentView_.backgroundColor = [UIColor colorWithWhite:0 alpha:0.75f];
+        contentView_.layer.cornerRadius = 10.0f;
+        [window_ addSubview:contentView_];
+
+        label_ = [[UILabel alloc] initWithFrame:CGRectInset(contentView_.bounds, 10.0f, 10.0f)];
+        label_.font = [UIFont boldSystemFontOfSize:20.0f];
+        label_.textColor = [UIColor whiteColor];
+        label_.backgroundColor = [UIColor clearColor];
+        label_.textAlignment = UITextAlignmentCenter;
+        label_.numberOfLines = 0;
+        [contentView_ addSubview:label_];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [label_ release];
+    [contentView_ release];
+    [window_ release];
+    [super dealloc];
+}
+
+- (BOOL)isVisible
+{
+    return !window_.hidden;
+}
+
+- (void)setTitle:(NSString *)title
+{
+    label_.text = title;
+}
+
+- (void)showWithTitle:(NSString *)title
+{
+    label_.text = title;
+
+    // Match orientation of the frontmost app
+    CGFloat angle = 0;
+    UIApplication *springBoard = [UIApplication sharedApplication];
+    if ([springBoard respondsToSelector:@selector(_frontMostAppOrientation)]) {
+        switch ([(SpringBoard *)springBoard _frontMostAppOrientation]) {
+            case UIInterfaceOrientationPortraitUpsideDown: angle = M_PI; break;
+            case UIInterfaceOrientationLandscapeLeft: angle = -M_PI_2; break;
+            case UIInterfaceOrientationLandscapeRight: angle = M_PI_2; break;
+            default: break;
+        }
+    }
+    contentView_.transform = CGAffineTransformMakeRotation(angle);
+
+    if (window_.hidden) {
+        contentView_.alpha = 0;
+        window_.hidden = NO;
+    }
+
+    [UIView beginAnimations:nil context:NULL];
+    [UIView setAnimationDuration:kHUDFadeDuration];
+    [UIView setAnimationBeginsFromCurrentState:YES];
+    contentView_.alpha = 1.0f;
+    [UIView commitAnimations];
+}
+
+- (void)hide
+{
+    if (window_.hidden)
+        return;
+
+    [UIView beginAnimations:nil context:NULL];
+    [UIView setAnimationDuration:kHUDFadeDuration];
+    [UIView setAnimationBeginsFromCurrentState:YES];
+    [UIView setAnimationDelegate:self];
+    [UIView setAnimationDidStopSelector:@selector(fadeOutDidStop:finished:context:)];
+    contentView_.alpha = 0;
+    [UIView commitAnimations];
+}
+
+- (void)fadeOutDidStop:(NSString *)animationID finished:(NSNumber *)finished context:(void *)context
+{
+    // NOTE: May have been shown again while fading out
+    if (contentView_.alpha == 0)
+        window_.hidden = YES;
+}
+
+@end
+
+/* vim: set filetype=objcpp sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */
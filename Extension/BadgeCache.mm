@@ -0,0 +1,133 @@
+/**
+ * Name: Backgrounder
+ * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
+ * Description: allow applications to run in the background
+ * Author: Lance Fetters (aka. ashikase)
+ * Last-modified: 2026-10-17 10:12:45
+ */
+
+/**
+ * Copyright (C) 2008-2010  Lance Fetters (aka. ashikase)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "BadgeCache.h"
+
+#import <QuartzCore/QuartzCore.h>
+
+#define kBadgeTag 1000
+
+// Maximum number of unused badge views to keep
+#define kBadgePoolSize 16
+
+@interface NSObject (BadgeCache)
++ (CGSize)defaultIconImageSize;
+@end
+
+static BOOL hasGeometry_ = NO;
+static CGPoint badgeOrigin_;
+
+static UIImage *badgeImages_[2] = {nil, nil};
+
+static NSMutableArray *pool_ = nil;
+
+//==============================================================================
+
+static void loadGeometry(UIView *icon)
+{
+    // Determine origin for badge based on icon image size
+    // NOTE: Default icon image sizes: iPhone/iPod: 59x62, iPad: 74x76 
+    Class $Icon = [icon class];
+    if ([$Icon respondsToSelector:@selector(defaultIconImageSize)]) {
+        // Determine position for badge (relative to lower left corner of icon)
+        CGSize size = [$Icon defaultIconImageSize];
+        badgeOrigin_ = CGPointMake(-12.0f, size.height - 23.0f);
+    } else {
+        // Fall back to hard-coded values (for firmware < 3.2, iPhone/iPod only)
+        badgeOrigin_ = CGPointMake(-12.0f, 39.0f);
+    }
+    hasGeometry_ = YES;
+}
+
+static UIImage *badgeImage(BGBadgeType type)
+{
+    if (badgeImages_[type] == nil) {
+        NSString *fileName = (type == BGBadgeTypeBackgrounder) ?
+            @"Backgrounder_Badge.png" : @"Backgrounder_NativeBadge.png";
+        badgeImages_[type] = [[UIImage imageNamed:fileName] retain];
+    }
+    return badgeImages_[type];
+}
+
+void addBadgeToIcon(UIView *icon, BGBadgeType type)
+{
+    if (icon == nil)
+        return;
+
+    if (!hasGeometry_)
+        loadGeometry(icon);
+
+    UIView *badgeView = [icon viewWithTag:kBadgeTag];
+    if (badgeView == nil) {
+        badgeView = [pool_ lastObject];
+        if (badgeView != nil) {
+            [badgeView retain];
+            [pool_ removeLastObject];
+        } else {
+            badgeView = [[UIView alloc] initWithFrame:CGRectZero];
+            badgeView.tag = kBadgeTag;
+            badgeView.userInteractionEnabled = NO;
+        }
+        [icon addSubview:badgeView];
+        [badgeView release];
+    }
+
+    // NOTE: Image contents are shared by all badge views of the same type
+    UIImage *image = badgeImage(type);
+    badgeView.layer.contents = (id)[image CGImage];
+    badgeView.frame = CGRectMake(badgeOrigin_.x, badgeOrigin_.y, image.size.width, image.size.height);
+}
+
+void removeBadgeFromIcon(UIView *icon)
+{
+    UIView *badgeView = [icon viewWithTag:kBadgeTag];
+    if (badgeView == nil)
+        return;
+
+    if (pool_ == nil)
+        pool_ = [[NSMutableArray alloc] initWithCapacity:kBadgePoolSize];
+    if ([pool_ count] < kBadgePoolSize)
+        [pool_ addObject:badgeView];
+    [badgeView removeFromSuperview];
+}
+
+/* vim: set filetype=objcpp sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */
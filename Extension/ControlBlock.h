@@ -0,0 +1,80 @@
+/**
+ * Name: Backgrounder
+ * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
+ * Description: allow applications to run in the background
+ * Author: Lance Fetters (aka. ashikase)
+ * Last-modified: 2026-10-17 22:57:55
+ */
+
+/**
+ * Copyright (C) 2008-2010  Lance Fetters (aka. ashikase)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#define BG_CONTROL_BLOCK_VERSION 3
+
+// Per-app block of shared memory used by SpringBoard to set the backgrounding
+// state of an application.
+// NOTE: The block is created by the application once its hooks are installed;
+//       SpringBoard only writes to blocks that already exist.
+// NOTE: Once the version is set, SpringBoard writes enabled and then
+//       increments generation. The application only writes ackGeneration,
+//       setting it to the generation it has since applied.
+typedef struct {
+    volatile uint32_t version;
+    volatile uint32_t generation;
+    volatile uint32_t enabled;
+    volatile uint32_t ackGeneration;
+} BGControlBlock;
+
+// Application side
+BGControlBlock *createControlBlock(bool enabled);
+bool readControlBlockEnabled(BGControlBlock *block);
+// NOTE: Read the generation before the state it is to acknowledge.
+uint32_t readControlBlockGeneration(BGControlBlock *block);
+void acknowledgeControlBlock(BGControlBlock *block, uint32_t generation);
+
+// SpringBoard side
+// NOTE: The mapping of each block is kept until destroyControlBlock is called
+//       for the app's pid.
+bool writeControlBlockEnabled(pid_t pid, bool enabled);
+// NOTE: Returns false if the app has no control block.
+bool peekControlBlockEnabled(pid_t pid, bool *enabled);
+// NOTE: Returns false if the app has no control block; otherwise sets
+//       acknowledged to whether the app has applied the last write.
+bool peekControlBlockAcknowledged(pid_t pid, bool *acknowledged);
+void destroyControlBlock(pid_t pid);
+
+/* vim: set filetype=objcpp sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */
@@ -0,0 +1,207 @@
+/**
+ * Name: Backgrounder
+ * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
+ * Description: allow applications to run in the background
+ * Author: Lance Fetters (aka. ashikase)
+ * Last-modified: 2026-10-17 22:57:55
+ */
+
+/**
+ * Copyright (C) 2008-2010  Lance Fetters (aka. ashikase)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "ControlBlock.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <map>
+
+// NOTE: Names of POSIX shared memory objects are limited to 31 characters.
+static inline void nameForPid(pid_t pid, char *name, size_t size)
+{
+    snprintf(name, size, "/jp.ashikase.bg.%d", pid);
+}
+
+//==============================================================================
+
+BGControlBlock *createControlBlock(bool enabled)
+{
+    char name[32];
+    nameForPid(getpid(), name, sizeof(name));
+
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd == -1 && errno == EEXIST) {
+        // Left behind by an earlier process with the same pid; replace it
+        shm_unlink(name);
+        fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0644);
+    }
+    if (fd == -1)
+        // NOTE: May fail if the app's sandbox does not permit shared memory
+        return NULL;
+
+    BGControlBlock *block = NULL;
+    if (ftruncate(fd, sizeof(BGControlBlock)) == 0) {
+        void *addr = mmap(NULL, sizeof(BGControlBlock), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (addr != MAP_FAILED) {
+            block = reinterpret_cast<BGControlBlock *>(addr);
+            block->generation = 0;
+            block->enabled = enabled ? 1 : 0;
+            block->ackGeneration = 0;
+
+            // NOTE: SpringBoard ignores the block until the version is set
+            __sync_synchronize();
+            block->version = BG_CONTROL_BLOCK_VERSION;
+        }
+    }
+    close(fd);
+
+    if (block == NULL)
+        shm_unlink(name);
+
+    return block;
+}
+
+bool readControlBlockEnabled(BGControlBlock *block)
+{
+    return (block->enabled != 0);
+}
+
+uint32_t readControlBlockGeneration(BGControlBlock *block)
+{
+    // NOTE: SpringBoard writes enabled before generation; a state read after
+    //       this is at least as new as the returned generation.
+    uint32_t generation = block->generation;
+    __sync_synchronize();
+    return generation;
+}
+
+void acknowledgeControlBlock(BGControlBlock *block, uint32_t generation)
+{
+    if (block->ackGeneration != generation) {
+        __sync_synchronize();
+        block->ackGeneration = generation;
+    }
+}
+
+//==============================================================================
+
+// NOTE: Blocks are mapped on first use and kept mapped until the app exits, so
+//       that toggling backgrounding does not cost a round of system calls.
+static std::map<pid_t, BGControlBlock *> mappedBlocks_;
+
+static BGControlBlock *mappedBlockForPid(pid_t pid)
+{
+    std::map<pid_t, BGControlBlock *>::iterator it = mappedBlocks_.find(pid);
+    if (it != mappedBlocks_.end())
+        return it->second;
+
+    char name[32];
+    nameForPid(pid, name, sizeof(name));
+
+    int fd = shm_open(name, O_RDWR, 0);
+    if (fd == -1)
+        // App has not (yet) installed its hooks
+        return NULL;
+
+    BGControlBlock *block = NULL;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(BGControlBlock)) {
+        void *addr = mmap(NULL, sizeof(BGControlBlock), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (addr != MAP_FAILED) {
+            block = reinterpret_cast<BGControlBlock *>(addr);
+            if (block->version == BG_CONTROL_BLOCK_VERSION) {
+                mappedBlocks_[pid] = block;
+            } else {
+                // Block is not yet (or not fully) initialized; try again later
+                munmap(addr, sizeof(BGControlBlock));
+                block = NULL;
+            }
+        }
+    }
+    close(fd);
+
+    return block;
+}
+
+bool writeControlBlockEnabled(pid_t pid, bool enabled)
+{
+    BGControlBlock *block = mappedBlockForPid(pid);
+    if (block == NULL)
+        return false;
+
+    // NOTE: Explicit state (not a toggle); repeated writes are harmless
+    block->enabled = enabled ? 1 : 0;
+    __sync_synchronize();
+    block->generation = block->generation + 1;
+    return true;
+}
+
+bool peekControlBlockEnabled(pid_t pid, bool *enabled)
+{
+    BGControlBlock *block = mappedBlockForPid(pid);
+    if (block == NULL)
+        return false;
+
+    *enabled = (block->enabled != 0);
+    return true;
+}
+
+bool peekControlBlockAcknowledged(pid_t pid, bool *acknowledged)
+{
+    BGControlBlock *block = mappedBlockForPid(pid);
+    if (block == NULL)
+        return false;
+
+    *acknowledged = (block->ackGeneration == block->generation);
+    return true;
+}
+
+void destroyControlBlock(pid_t pid)
+{
+    std::map<pid_t, BGControlBlock *>::iterator it = mappedBlocks_.find(pid);
+    if (it != mappedBlocks_.end()) {
+        munmap(it->second, sizeof(BGControlBlock));
+        mappedBlocks_.erase(it);
+    }
+
+    char name[32];
+    nameForPid(pid, name, sizeof(name));
+    shm_unlink(name);
+}
+
+/* vim: set filetype=objcpp sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */
@@ -227,25 +227,8 @@ typedef struct {
 - (void)endBackgroundTask:(unsigned)task;
 @end
 
-@interface UIModalView : UIView
-@property(copy, nonatomic) NSString *message;
-@property(copy, nonatomic) NSString *title;
-- (void)setNumberOfRows:(int)rows;
-@end
-
 //==============================================================================
 
-@protocol UIModalViewDelegate @end
-@interface SBAlertItem : NSObject <UIModalViewDelegate>
-- (id)alertSheet;
-- (void)dismiss;
-@end
-
-@interface SBAlertItemsController : NSObject
-+ (id)sharedInstance;
-- (void)activateAlertItem:(id)item;
-@end
-
 @interface SBApplicationController : NSObject
 + (id)sharedInstance;
 - (id)applicationWithDisplayIdentifier:(id)displayIdentifier;
@@ -334,6 +317,7 @@ typedef struct {
 
 @protocol SBWiFiManagerDelegate @end
 @interface SpringBoard : UIApplication <UIApplicationDelegate, SBWiFiManagerDelegate>
+- (int)_frontMostAppOrientation;
 - (void)_setLockButtonTimer:(id)timer;
 @end
 @interface SpringBoard (Firmware3x)
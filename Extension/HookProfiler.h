@@ -0,0 +1,116 @@
+/**
+ * Name: Backgrounder
+ * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
+ * Description: allow applications to run in the background
+ * Author: Lance Fetters (aka. ashikase)
+ * Last-modified: 2026-10-17 22:28:04
+ */
+
+/**
+ * Copyright (C) 2008-2010  Lance Fetters (aka. ashikase)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef BG_HOOKPROFILER_H
+#define BG_HOOKPROFILER_H
+
+// Latency profiling of hook bodies
+// NOTE: Only compiled in if PROFILE_HOOKS is defined (build with
+//       "make PROFILE_HOOKS=1"); otherwise BG_PROFILE_HOOK() expands to
+//       nothing.
+// NOTE: Place BG_PROFILE_HOOK() at the start of a hook body; the time until
+//       the body returns (including the original implementation and any
+//       nested hooks) is recorded in a per-hook log-linear histogram, and
+//       in a ring buffer of recent calls. Recording is lock-free and may be
+//       done from any thread.
+// NOTE: The profile is written on receipt of the Darwin notification
+//       "jp.ashikase.backgrounder.dumpHookProfile", as a trace file that can
+//       be loaded into chrome://tracing (or Perfetto); the histograms are
+//       included under the "hookHistograms" key.
+
+#ifdef PROFILE_HOOKS
+
+#include <stdint.h>
+
+// NOTE: Eight linear buckets per power of two of clock ticks
+#define BG_HOOK_HISTOGRAM_SUB_BUCKETS 8
+#define BG_HOOK_HISTOGRAM_BUCKETS 320
+
+typedef struct {
+    const char *name;
+    volatile uint32_t buckets[BG_HOOK_HISTOGRAM_BUCKETS];
+    volatile uint64_t count;
+    volatile uint64_t totalTicks;
+    volatile uint64_t maxTicks;
+} BGHookHistogram;
+
+// Returns NULL if too many hooks have been registered
+BGHookHistogram *bgRegisterHook(const char *functionName);
+uint64_t bgHookClock();
+void bgRecordHookLatency(BGHookHistogram *histogram, uint64_t start, uint64_t ticks);
+
+unsigned bgHookHistogramBucket(uint64_t ticks);
+uint64_t bgHookHistogramBucketLowerBound(unsigned bucket);
+
+// Call once at startup to listen for the dump notification
+void initHookProfiler(const char *processName);
+
+// NOTE: Returns false if the file could not be written.
+bool dumpHookProfile(const char *path);
+
+class BGHookTimer {
+    public:
+        BGHookTimer(BGHookHistogram *histogram) : histogram_(histogram), start_(bgHookClock()) {}
+        ~BGHookTimer() {
+            if (histogram_ != 0)
+                bgRecordHookLatency(histogram_, start_, bgHookClock() - start_);
+        }
+
+    private:
+        BGHookHistogram *histogram_;
+        uint64_t start_;
+};
+
+// NOTE: Registration happens once per call site.
+#define BG_PROFILE_HOOK() \
+    static BGHookHistogram *_bgHookHistogram = bgRegisterHook(__FUNCTION__); \
+    BGHookTimer _bgHookTimer(_bgHookHistogram)
+
+#else
+
+#define BG_PROFILE_HOOK()
+
+#endif // PROFILE_HOOKS
+
+#endif // BG_HOOKPROFILER_H
+
+/* vim: set filetype=objcpp sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */
@@ -0,0 +1,321 @@
+/**
+ * Name: Backgrounder
+ * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
+ * Description: allow applications to run in the background
+ * Author: Lance Fetters (aka. ashikase)
+ * Last-modified: 2026-10-17 22:28:04
+ */
+
+/**
+ * Copyright (C) 2008-2010  Lance Fetters (aka. ashikase)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "HookProfiler.h"
+
+#ifdef PROFILE_HOOKS
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef __APPLE__
+#include <CoreFoundation/CoreFoundation.h>
+#include <mach/mach_time.h>
+#include <pthread.h>
+#else
+#include <time.h>
+#endif
+
+// NOTE: Apart from the dump notification, this file uses only portable C++
+//       and POSIX calls.
+
+#define kMaxHooks 128
+
+// NOTE: Must be a power of two
+#define kSampleCapacity 4096
+
+typedef struct {
+    uint32_t hook;
+    uint32_t mainThread;
+    uint64_t start;
+    uint64_t ticks;
+} BGHookSample;
+
+static BGHookHistogram hooks_[kMaxHooks];
+static volatile uint32_t hookCount_ = 0;
+
+// Ring buffer of recent calls
+// NOTE: A slot is claimed atomically, but not written atomically; a dump
+//       taken while hooks are running may include a partially written sample.
+static BGHookSample samples_[kSampleCapacity];
+static volatile uint64_t sampleCursor_ = 0;
+
+static char processName_[64] = "";
+
+//==============================================================================
+
+uint64_t bgHookClock()
+{
+#ifdef __APPLE__
+    return mach_absolute_time();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+}
+
+static double nanosecondsPerTick()
+{
+#ifdef __APPLE__
+    mach_timebase_info_data_t timebase;
+    mach_timebase_info(&timebase);
+    return (double)timebase.numer / timebase.denom;
+#else
+    return 1.0;
+#endif
+}
+
+static inline bool isMainThread()
+{
+#ifdef __APPLE__
+    return pthread_main_np() != 0;
+#else
+    return true;
+#endif
+}
+
+unsigned bgHookHistogramBucket(uint64_t ticks)
+{
+    const unsigned sub = BG_HOOK_HISTOGRAM_SUB_BUCKETS;
+    if (ticks < sub)
+        return ticks;
+
+    // NOTE: exponent is at least 3 here
+    unsigned exponent = 63 - __builtin_clzll(ticks);
+    unsigned bucket = (exponent - 2) * sub + ((ticks >> (exponent - 3)) & (sub - 1));
+    return (bucket < BG_HOOK_HISTOGRAM_BUCKETS) ? bucket : BG_HOOK_HISTOGRAM_BUCKETS - 1;
+}
+
+uint64_t bgHookHistogramBucketLowerBound(unsigned bucket)
+{
+    const unsigned sub = BG_HOOK_HISTOGRAM_SUB_BUCKETS;
+    if (bucket < sub)
+        return bucket;
+
+    unsigned exponent = bucket / sub + 2;
+    return (uint64_t)(sub + bucket % sub) << (exponent - 3);
+}
+
+BGHookHistogram *bgRegisterHook(const char *functionName)
+{
+    uint32_t index = __sync_fetch_and_add(&hookCount_, 1);
+    if (index >= kMaxHooks)
+        return NULL;
+
+    BGHookHistogram *histogram = &hooks_[index];
+    histogram->name = functionName;
+    return histogram;
+}
+
+void bgRecordHookLatency(BGHookHistogram *histogram, uint64_t start, uint64_t ticks)
+{
+    __sync_fetch_and_add(&histogram->buckets[bgHookHistogramBucket(ticks)], 1);
+    __sync_fetch_and_add(&histogram->count, 1);
+    __sync_fetch_and_add(&histogram->totalTicks, ticks);
+
+    uint64_t max = histogram->maxTicks;
+    while (ticks > max) {
+        uint64_t previous = __sync_val_compare_and_swap(&histogram->maxTicks, max, ticks);
+        if (previous == max)
+            break;
+        max = previous;
+    }
+
+    uint64_t cursor = __sync_fetch_and_add(&sampleCursor_, 1);
+    BGHookSample &sample = samples_[cursor & (kSampleCapacity - 1)];
+    sample.hook = histogram - hooks_;
+    sample.mainThread = isMainThread();
+    sample.start = start;
+    sample.ticks = ticks;
+}
+
+//==============================================================================
+
+// Convert a Logos-generated function name to a method name
+// NOTE: For example, "_logos_method$GMethodAll$UIApplication$applicationSuspend$"
+//       becomes "-[UIApplication applicationSuspend:]".
+static void formatHookName(const char *functionName, char *buf, size_t size)
+{
+    const char *prefix = "_logos_method$";
+    if (strncmp(functionName, prefix, strlen(prefix)) != 0) {
+        snprintf(buf, size, "%s", functionName);
+        return;
+    }
+
+    // Skip the group name
+    const char *klass = strchr(functionName + strlen(prefix), '$');
+    const char *selector = (klass != NULL) ? strchr(klass + 1, '$') : NULL;
+    if (selector == NULL) {
+        snprintf(buf, size, "%s", functionName);
+        return;
+    }
+    ++klass;
+    ++selector;
+
+    int length = snprintf(buf, size, "-[%.*s %s]", (int)(selector - klass - 1), klass, selector);
+    if (length > 0) {
+        // NOTE: Logos replaces the colons of the selector with dollar signs
+        for (char *p = buf + (selector - klass) + 2; *p != '\0'; ++p)
+            if (*p == '$')
+                *p = ':';
+    }
+}
+
+static uint64_t percentile(const BGHookHistogram *histogram, uint64_t count, double fraction)
+{
+    uint64_t target = (uint64_t)(count * fraction);
+    uint64_t seen = 0;
+    for (unsigned i = 0; i < BG_HOOK_HISTOGRAM_BUCKETS; ++i) {
+        seen += histogram->buckets[i];
+        if (seen > target)
+            return bgHookHistogramBucketLowerBound(i);
+    }
+    return histogram->maxTicks;
+}
+
+bool dumpHookProfile(const char *path)
+{
+    FILE *file = fopen(path, "w");
+    if (file == NULL)
+        return false;
+
+    double nsPerTick = nanosecondsPerTick();
+    unsigned hookCount = (hookCount_ < kMaxHooks) ? hookCount_ : kMaxHooks;
+    int pid = getpid();
+
+    char name[256];
+    fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"%s\"}}",
+        pid, processName_);
+
+    // Recent calls, oldest first
+    uint64_t cursor = sampleCursor_;
+    uint64_t first = (cursor > kSampleCapacity) ? cursor - kSampleCapacity : 0;
+    uint64_t origin = 0;
+    for (uint64_t i = first; i < cursor; ++i) {
+        const BGHookSample &sample = samples_[i & (kSampleCapacity - 1)];
+        if (sample.hook >= hookCount)
+            continue;
+        if (origin == 0 || sample.start < origin)
+            origin = sample.start;
+    }
+    for (uint64_t i = first; i < cursor; ++i) {
+        const BGHookSample &sample = samples_[i & (kSampleCapacity - 1)];
+        if (sample.hook >= hookCount)
+            continue;
+        formatHookName(hooks_[sample.hook].name, name, sizeof(name));
+        fprintf(file, ",\n{\"name\":\"%s\",\"cat\":\"hook\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%u}",
+            name, (sample.start - origin) * nsPerTick / 1000.0, sample.ticks * nsPerTick / 1000.0,
+            pid, sample.mainThread ? 1 : 2);
+    }
+    fprintf(file, "\n],\n\"hookHistograms\":[");
+
+    // Histograms, with bucket bounds and statistics in nanoseconds
+    // NOTE: Only non-empty buckets are listed, as [lower bound, count] pairs.
+    for (unsigned i = 0; i < hookCount; ++i) {
+        const BGHookHistogram *histogram = &hooks_[i];
+        uint64_t count = histogram->count;
+        formatHookName(histogram->name, name, sizeof(name));
+        fprintf(file, "%s\n{\"name\":\"%s\",\"count\":%llu,\"totalNs\":%.0f,\"maxNs\":%.0f,"
+            "\"p50Ns\":%.0f,\"p90Ns\":%.0f,\"p99Ns\":%.0f,\"buckets\":[",
+            (i == 0) ? "" : ",", name, (unsigned long long)count,
+            histogram->totalTicks * nsPerTick, histogram->maxTicks * nsPerTick,
+            percentile(histogram, count, 0.5) * nsPerTick,
+            percentile(histogram, count, 0.9) * nsPerTick,
+            percentile(histogram, count, 0.99) * nsPerTick);
+        bool isFirst = true;
+        for (unsigned j = 0; j < BG_HOOK_HISTOGRAM_BUCKETS; ++j) {
+            uint32_t bucketCount = histogram->buckets[j];
+            if (bucketCount == 0)
+                continue;
+            fprintf(file, "%s[%.0f,%u]", isFirst ? "" : ",",
+                bgHookHistogramBucketLowerBound(j) * nsPerTick, bucketCount);
+            isFirst = false;
+        }
+        fprintf(file, "]}");
+    }
+    fprintf(file, "\n]}\n");
+
+    bool ret = (ferror(file) == 0);
+    return (fclose(file) == 0) && ret;
+}
+
+//==============================================================================
+
+#ifdef __APPLE__
+
+// Callback
+static void dumpRequested(CFNotificationCenterRef center, void *observer,
+    CFStringRef name, const void *object, CFDictionaryRef userInfo)
+{
+    char path[PATH_MAX];
+    snprintf(path, sizeof(path), "/var/mobile/Library/Logs/jp.ashikase.backgrounder.%s.%d.json",
+        processName_, getpid());
+    if (!dumpHookProfile(path)) {
+        // NOTE: Sandboxed apps cannot write outside of their container
+        const char *tmpdir = getenv("TMPDIR");
+        snprintf(path, sizeof(path), "%s/jp.ashikase.backgrounder.%s.%d.json",
+            (tmpdir != NULL) ? tmpdir : "/tmp", processName_, getpid());
+        dumpHookProfile(path);
+    }
+}
+
+#endif
+
+void initHookProfiler(const char *processName)
+{
+    snprintf(processName_, sizeof(processName_), "%s", processName);
+
+#ifdef __APPLE__
+    CFNotificationCenterAddObserver(CFNotificationCenterGetDarwinNotifyCenter(),
+        NULL, dumpRequested, CFSTR(APP_ID".dumpHookProfile"), NULL,
+        CFNotificationSuspensionBehaviorDeliverImmediately);
+#endif
+}
+
+#endif // PROFILE_HOOKS
+
+/* vim: set filetype=objcpp sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */
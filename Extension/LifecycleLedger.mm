@@ -0,0 +1,207 @@
+/**
+ * Name: Backgrounder
+ * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
+ * Description: allow applications to run in the background
+ * Author: Lance Fetters (aka. ashikase)
+ * Last-modified: 2026-10-17 22:44:02
+ */
+
+/**
+ * Copyright (C) 2008-2010  Lance Fetters (aka. ashikase)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "LifecycleLedger.h"
+
+#import <CoreFoundation/CoreFoundation.h>
+
+#include <fcntl.h>
+#include <mach/mach_time.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#import "AppRegistry.h"
+
+#define kLedgerCapacity 1024
+
+// Write to disk once the buffer is this full, or at the interval (in seconds)
+#define kLedgerFlushThreshold 768
+#define kLedgerFlushInterval 300.0
+
+// Rotate the log once it grows beyond this size (in bytes)
+#define kLedgerMaxFileSize (1024 * 1024)
+
+// Ring buffer of events not yet written to disk
+static BGLedgerEvent events_[kLedgerCapacity];
+static unsigned head_ = 0;
+static unsigned count_ = 0;
+static unsigned dropped_ = 0;
+
+// NOTE: App IDs are assigned in increasing order, so only the number of IDs
+//       already named in the current log file needs to be tracked.
+static BOOL sessionWritten_ = NO;
+static BGAppID namedAppCount_ = 0;
+
+static CFRunLoopTimerRef flushTimer_ = NULL;
+
+//==============================================================================
+
+static void flushTimerFired(CFRunLoopTimerRef timer, void *info)
+{
+    flushLifecycleLedger();
+}
+
+void recordLifecycleEvent(NSString *displayId, BGLedgerEventType type, unsigned arg)
+{
+    if (displayId == nil)
+        return;
+
+    BGLedgerEvent *event;
+    if (count_ == kLedgerCapacity) {
+        // Buffer is full; overwrite the oldest event
+        event = &events_[head_];
+        head_ = (head_ + 1) % kLedgerCapacity;
+        ++dropped_;
+    } else {
+        event = &events_[(head_ + count_) % kLedgerCapacity];
+        ++count_;
+    }
+    event->timestamp = mach_absolute_time();
+    event->appId = internDisplayIdentifier(displayId);
+    event->type = type;
+    event->arg = arg;
+
+    if (count_ >= kLedgerFlushThreshold) {
+        flushLifecycleLedger();
+    } else if (flushTimer_ == NULL) {
+        flushTimer_ = CFRunLoopTimerCreate(kCFAllocatorDefault,
+            CFAbsoluteTimeGetCurrent() + kLedgerFlushInterval, kLedgerFlushInterval,
+            0, 0, flushTimerFired, NULL);
+        CFRunLoopAddTimer(CFRunLoopGetMain(), flushTimer_, kCFRunLoopCommonModes);
+    }
+}
+
+// NOTE: The new file must start with its own session header and names.
+static void rotateLedger(const char *path)
+{
+    char oldPath[PATH_MAX];
+    snprintf(oldPath, sizeof(oldPath), "%s.old", path);
+    rename(path, oldPath);
+    sessionWritten_ = NO;
+    namedAppCount_ = 0;
+}
+
+void flushLifecycleLedger()
+{
+    if (count_ == 0 && dropped_ == 0)
+        return;
+
+    const char *path = BG_LEDGER_FILE_PATH;
+
+    // Rotate the log if too large
+    struct stat st;
+    if (stat(path, &st) == 0 && st.st_size > kLedgerMaxFileSize)
+        rotateLedger(path);
+
+    int fd = open(path, O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd == -1)
+        // Keep events buffered; will retry at next flush
+        return;
+
+    // Size of the file before this chunk; used to undo a partial write
+    off_t recordBoundary = (fstat(fd, &st) == 0) ? st.st_size : -1;
+
+    NSMutableData *data = [[NSMutableData alloc] initWithCapacity:
+        sizeof(BGLedgerSessionHeader) + sizeof(BGLedgerChunkHeader) + count_ * sizeof(BGLedgerEvent)];
+
+    if (!sessionWritten_) {
+        mach_timebase_info_data_t timebase;
+        mach_timebase_info(&timebase);
+
+        BGLedgerSessionHeader session;
+        session.magic = BG_LEDGER_MAGIC_SESSION;
+        session.version = BG_LEDGER_VERSION;
+        session.reserved = 0;
+        session.timebaseNumer = timebase.numer;
+        session.timebaseDenom = timebase.denom;
+        session.startTime = time(NULL);
+        session.startTimestamp = mach_absolute_time();
+        [data appendBytes:&session length:sizeof(session)];
+    }
+
+    BGAppID appCount = (BGAppID)::appCount();
+
+    BGLedgerChunkHeader chunk;
+    chunk.magic = BG_LEDGER_MAGIC_CHUNK;
+    chunk.nameCount = appCount - namedAppCount_;
+    chunk.eventCount = count_;
+    chunk.droppedCount = dropped_;
+    [data appendBytes:&chunk length:sizeof(chunk)];
+
+    // Names for apps first seen since the last flush
+    for (BGAppID appId = namedAppCount_; appId < appCount; ++appId) {
+        const char *name = [displayIdentifierForAppId(appId) UTF8String];
+        BGLedgerNameEntry entry;
+        entry.appId = appId;
+        entry.length = (name != NULL) ? strlen(name) : 0;
+        [data appendBytes:&entry length:sizeof(entry)];
+        [data appendBytes:name length:entry.length];
+    }
+
+    // Events, oldest first
+    unsigned firstPart = MIN(count_, kLedgerCapacity - head_);
+    [data appendBytes:&events_[head_] length:firstPart * sizeof(BGLedgerEvent)];
+    [data appendBytes:&events_[0] length:(count_ - firstPart) * sizeof(BGLedgerEvent)];
+
+    ssize_t written = write(fd, [data bytes], [data length]);
+    if (written == (ssize_t)[data length]) {
+        sessionWritten_ = YES;
+        namedAppCount_ = appCount;
+        head_ = 0;
+        count_ = 0;
+        dropped_ = 0;
+    } else if (written > 0) {
+        // Partial write (e.g. disk full); the events stay buffered and are
+        // written again in full, so remove the partial chunk from the file
+        // NOTE: If that fails, the partial chunk is left at the end of the
+        //       rotated file, where readers treat it as truncated.
+        if (recordBoundary < 0 || ftruncate(fd, recordBoundary) != 0)
+            rotateLedger(path);
+    }
+    close(fd);
+
+    [data release];
+}
+
+/* vim: set filetype=objcpp sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */
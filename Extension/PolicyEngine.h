@@ -0,0 +1,160 @@
+/**
+ * Name: Backgrounder
+ * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
+ * Description: allow applications to run in the background
+ * Author: Lance Fetters (aka. ashikase)
+ * Last-modified: 2026-10-17 13:21:09
+ */
+
+/**
+ * Copyright (C) 2008-2010  Lance Fetters (aka. ashikase)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef BG_POLICYENGINE_H
+#define BG_POLICYENGINE_H
+
+#include "PreferenceConstants.h"
+
+// Backgrounding policy decisions, independent of SpringBoard and UIKit.
+// NOTE: This file intentionally uses only portable C++, so that policy
+//       changes can be replayed and measured off-device (see Tools/policy_sim).
+
+// Resolved policy inputs for a single application
+// NOTE: The backgrounding method is as returned by bgResolveMethod(); it is
+//       never AutoDetect or Throttled.
+struct BGPolicyInput {
+    BGBackgroundingMethod method;
+    bool throttled;
+    bool fallbackToNative;
+    bool persistent;
+    bool enableAtLaunch;
+    bool statusBarIconEnabled;
+    bool fastAppSwitchingEnabled;
+    bool forceFastAppSwitching;
+    bool firmware3x;
+};
+
+// Lifecycle states
+typedef enum {
+    BGPolicyStateNotRunning = 0,
+    BGPolicyStateForeground,
+    // Kept running by the Backgrounder method
+    BGPolicyStateBackground,
+    // Suspended (or running, for apps with background modes) natively
+    BGPolicyStateSuspended,
+    BGPolicyStateCount
+} BGPolicyState;
+
+// Lifecycle events
+typedef enum {
+    BGPolicyEventLaunch = 0,
+    BGPolicyEventResume,
+    BGPolicyEventDeactivate,
+    BGPolicyEventEnable,
+    BGPolicyEventDisable,
+    // NOTE: An abnormal exit is followed by BGPolicyEventExit.
+    BGPolicyEventCrash,
+    BGPolicyEventExit,
+    // SpringBoard is deciding whether to relaunch a terminated app
+    BGPolicyEventRelaunchCheck,
+    BGPolicyEventCount
+} BGPolicyEvent;
+
+// Actions to be performed by the caller after a transition
+enum {
+    BGPolicyActionEnableBackgrounding  = 1 << 0,
+    BGPolicyActionDisableBackgrounding = 1 << 1,
+    BGPolicyActionUpdateIndicator      = 1 << 2,
+    // Hold the app in the event-only state so that it keeps running
+    BGPolicyActionKeepRunning          = 1 << 3,
+    // Terminate the app instead of suspending it (firmware 4.x+)
+    BGPolicyActionQuit                 = 1 << 4,
+    BGPolicyActionStartThrottling      = 1 << 5,
+    // Show the native badge for an app set to fall back to native
+    BGPolicyActionShowFallbackBadge    = 1 << 6,
+    BGPolicyActionPermitRelaunch       = 1 << 7,
+    BGPolicyActionRelaunch             = 1 << 8,
+    // Event is not valid in the current state; record was not changed
+    BGPolicyActionRejected             = 0x80000000
+};
+
+// Per-application state tracked by the state machine
+struct BGPolicyRecord {
+    BGPolicyState state;
+    bool backgroundingEnabled;
+    bool permittedToRelaunch;
+};
+
+// Apply an event to an application's record
+// NOTE: Returns the BGPolicyAction flags that the caller must act upon.
+unsigned bgPolicyTransition(BGPolicyRecord *record, BGPolicyEvent event, const BGPolicyInput &input);
+
+//==============================================================================
+
+// Determine the backgrounding method actually used for a stored method
+// NOTE: throttled (if non-NULL) is set if the stored method is Throttled.
+BGBackgroundingMethod bgResolveMethod(BGBackgroundingMethod stored, bool firmware3x,
+    bool exitsOnSuspend, bool supportsMultitask, bool *throttled);
+
+// Determine whether the app will remain in memory when suspended (4.x+)
+bool bgWillMultitask(const BGPolicyInput &input, bool supportsMultitask, bool hasBackgroundModes);
+
+// Status bar indicator for the foreground application
+typedef enum {
+    BGIndicatorNone = 0,
+    BGIndicatorBackgrounder,
+    BGIndicatorNative
+} BGIndicator;
+
+BGIndicator bgIndicator(const BGPolicyInput &input, bool backgroundingEnabled,
+    bool supportsMultitask, bool hasBackgroundModes);
+
+// Determine whether the app may be launched when SpringBoard starts
+bool bgPermitLaunchAtBoot(const BGPolicyInput &input);
+
+// Setup performed within the application process (firmware 4.x+)
+enum {
+    // Mark the app as not supporting native suspension
+    BGAppSetupDisableNative           = 1 << 0,
+    // Clear the flag that prevents native suspension (respects exit-on-suspend)
+    BGAppSetupForceFastAppSwitching   = 1 << 1,
+    // Terminate, rather than suspend, once background tasks complete
+    BGAppSetupDisableFastAppSwitching = 1 << 2,
+    BGAppSetupBackgrounderHooks       = 1 << 3
+};
+
+unsigned bgAppSetupActions(const BGPolicyInput &input, bool hasBackgroundModes);
+
+#endif // BG_POLICYENGINE_H
+
+/* vim: set filetype=objcpp sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */
@@ -0,0 +1,269 @@
+/**
+ * Name: Backgrounder
+ * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
+ * Description: allow applications to run in the background
+ * Author: Lance Fetters (aka. ashikase)
+ * Last-modified: 2026-10-17 13:21:09
+ */
+
+/**
+ * Copyright (C) 2008-2010  Lance Fetters (aka. ashikase)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "PolicyEngine.h"
+
+#include <stddef.h>
+
+// NOTE: This file intentionally uses only portable C++.
+
+// Special entries in the transition table
+#define kInvalid  -1
+#define kSame     -2
+// Next state depends on the app's policy; see bgPolicyTransition()
+#define kDecide   -3
+
+static const signed char transitions_[BGPolicyStateCount][BGPolicyEventCount] = {
+    //                  Launch                   Resume                   Deactivate  Enable    Disable                  Crash                    Exit                     RelaunchCheck
+    /* NotRunning */  { BGPolicyStateForeground, kInvalid,                kInvalid,   kInvalid, kInvalid,                kInvalid,                kSame,                   kDecide  },
+    /* Foreground */  { kInvalid,                kInvalid,                kDecide,    kSame,    kSame,                   BGPolicyStateNotRunning, BGPolicyStateNotRunning, kInvalid },
+    /* Background */  { kInvalid,                BGPolicyStateForeground, kInvalid,   kSame,    BGPolicyStateSuspended,  BGPolicyStateNotRunning, BGPolicyStateNotRunning, kInvalid },
+    /* Suspended  */  { kInvalid,                BGPolicyStateForeground, kInvalid,   kSame,    kSame,                   BGPolicyStateNotRunning, BGPolicyStateNotRunning, kInvalid }
+};
+
+static inline bool usesFallback(const BGPolicyInput &input)
+{
+    // NOTE: Falling back to native only applies to the Backgrounder method
+    return input.method == BGBackgroundingMethodBackgrounder && input.fallbackToNative;
+}
+
+static unsigned setEnabled(BGPolicyRecord *record, bool enable, const BGPolicyInput &input)
+{
+    if (input.method == BGBackgroundingMethodOff || record->backgroundingEnabled == enable)
+        return 0;
+
+    record->backgroundingEnabled = enable;
+    return enable ? BGPolicyActionEnableBackgrounding : BGPolicyActionDisableBackgrounding;
+}
+
+unsigned bgPolicyTransition(BGPolicyRecord *record, BGPolicyEvent event, const BGPolicyInput &input)
+{
+    if (record->state >= BGPolicyStateCount || event >= BGPolicyEventCount)
+        return BGPolicyActionRejected;
+
+    int next = transitions_[record->state][event];
+    if (next == kInvalid)
+        return BGPolicyActionRejected;
+
+    unsigned actions = 0;
+    bool isOff = (input.method == BGBackgroundingMethodOff);
+    bool isBackgrounderMethod = (input.method == BGBackgroundingMethodBackgrounder);
+
+    switch (event) {
+        case BGPolicyEventLaunch:
+            if (!isOff) {
+                if (input.enableAtLaunch)
+                    actions = setEnabled(record, true, input);
+                else if (input.statusBarIconEnabled)
+                    // Must add the initial indicator for "Fall Back to Native"
+                    actions = BGPolicyActionUpdateIndicator;
+            }
+            break;
+        case BGPolicyEventResume:
+            if (!isOff) {
+                if (!input.persistent) {
+                    // NOTE: Always requested, so that any badge or indicator
+                    //       left from a previous state is removed.
+                    record->backgroundingEnabled = false;
+                    actions = BGPolicyActionDisableBackgrounding;
+                } else if (input.statusBarIconEnabled) {
+                    // Must re-add the indicator on resume
+                    actions = BGPolicyActionUpdateIndicator;
+                }
+            }
+            break;
+        case BGPolicyEventDeactivate: {
+            bool isEnabled = record->backgroundingEnabled;
+            bool fallback = usesFallback(input);
+            if (isEnabled && isBackgrounderMethod) {
+                actions |= BGPolicyActionKeepRunning;
+                if (input.throttled)
+                    actions |= BGPolicyActionStartThrottling;
+            }
+            if (!input.firmware3x && !isEnabled && !fallback)
+                actions |= BGPolicyActionQuit;
+            if (!isEnabled && fallback)
+                actions |= BGPolicyActionShowFallbackBadge;
+
+            if (actions & BGPolicyActionKeepRunning)
+                next = BGPolicyStateBackground;
+            else if ((actions & BGPolicyActionQuit) || input.firmware3x)
+                // NOTE: Firmware 3.x has no native suspension
+                next = BGPolicyStateNotRunning;
+            else
+                next = BGPolicyStateSuspended;
+            break;
+        }
+        case BGPolicyEventEnable:
+            actions = setEnabled(record, true, input);
+            break;
+        case BGPolicyEventDisable:
+            actions = setEnabled(record, false, input);
+            if (actions == 0)
+                // Nothing changed; remain in the current state
+                next = kSame;
+            break;
+        case BGPolicyEventCrash:
+            if (record->backgroundingEnabled || usesFallback(input)) {
+                // Allow app to relaunch (if it supports relaunching)
+                record->permittedToRelaunch = true;
+                actions = BGPolicyActionPermitRelaunch;
+            }
+            break;
+        case BGPolicyEventExit:
+            if (!isOff) {
+                // NOTE: Always requested; see Resume.
+                record->backgroundingEnabled = false;
+                actions = BGPolicyActionDisableBackgrounding;
+            }
+            break;
+        case BGPolicyEventRelaunchCheck:
+            if (record->permittedToRelaunch) {
+                // Permission is for a single relaunch
+                record->permittedToRelaunch = false;
+                actions = BGPolicyActionRelaunch;
+                next = BGPolicyStateSuspended;
+            } else {
+                next = kSame;
+            }
+            break;
+        default:
+            break;
+    }
+
+    if (next != kSame)
+        record->state = (BGPolicyState)next;
+    return actions;
+}
+
+//==============================================================================
+
+BGBackgroundingMethod bgResolveMethod(BGBackgroundingMethod stored, bool firmware3x,
+    bool exitsOnSuspend, bool supportsMultitask, bool *throttled)
+{
+    BGBackgroundingMethod method = stored;
+    bool isThrottled = (method == BGBackgroundingMethodThrottled);
+    if (isThrottled)
+        // NOTE: Throttling is handled by SpringBoard; otherwise the same as
+        //       the "Backgrounder" method.
+        method = BGBackgroundingMethodBackgrounder;
+
+    if (exitsOnSuspend) {
+        // Do not allow the app to be backgrounded
+        method = BGBackgroundingMethodOff;
+    } else if (method == BGBackgroundingMethodAutoDetect) {
+        // Use Native backgrounding method if supported, Backgrounder otherwise
+        method = (firmware3x || !supportsMultitask) ?
+            BGBackgroundingMethodBackgrounder : BGBackgroundingMethodNative;
+    } else if (method > BGBackgroundingMethodThrottled) {
+        // Unknown value (e.g. from a newer version); treat as off
+        method = BGBackgroundingMethodOff;
+    }
+
+    if (throttled != NULL)
+        *throttled = isThrottled && (method == BGBackgroundingMethodBackgrounder);
+    return method;
+}
+
+bool bgWillMultitask(const BGPolicyInput &input, bool supportsMultitask, bool hasBackgroundModes)
+{
+    if (input.firmware3x)
+        return false;
+
+    bool allowFastApp = input.fastAppSwitchingEnabled;
+    return (supportsMultitask && (allowFastApp || hasBackgroundModes))
+        || (allowFastApp && input.forceFastAppSwitching);
+}
+
+BGIndicator bgIndicator(const BGPolicyInput &input, bool backgroundingEnabled,
+    bool supportsMultitask, bool hasBackgroundModes)
+{
+    if (input.method == BGBackgroundingMethodOff || !input.statusBarIconEnabled)
+        return BGIndicatorNone;
+
+    bool isBackgrounderMethod = (input.method == BGBackgroundingMethodBackgrounder);
+    if (backgroundingEnabled && isBackgrounderMethod)
+        return BGIndicatorBackgrounder;
+
+    bool showNative = (backgroundingEnabled && !isBackgrounderMethod)
+        || (!input.firmware3x && !backgroundingEnabled && usesFallback(input));
+    if (!input.firmware3x)
+        showNative = showNative && bgWillMultitask(input, supportsMultitask, hasBackgroundModes);
+
+    return showNative ? BGIndicatorNative : BGIndicatorNone;
+}
+
+bool bgPermitLaunchAtBoot(const BGPolicyInput &input)
+{
+    return input.method == BGBackgroundingMethodNative || usesFallback(input);
+}
+
+unsigned bgAppSetupActions(const BGPolicyInput &input, bool hasBackgroundModes)
+{
+    unsigned actions = 0;
+
+    if (!input.firmware3x) {
+        if (input.method == BGBackgroundingMethodNative || usesFallback(input)) {
+            if (input.fastAppSwitchingEnabled) {
+                // NOTE: Only need to modify flag if "force" option is set;
+                //       apps updated for iOS4 will already have the flag set to zero.
+                if (input.forceFastAppSwitching)
+                    actions |= BGAppSetupForceFastAppSwitching;
+            } else if (!hasBackgroundModes) {
+                // App does not support audio/gps/voip; disable fast app switching
+                actions |= BGAppSetupDisableFastAppSwitching;
+            }
+        }
+
+        if (input.method == BGBackgroundingMethodOff
+                || (input.method == BGBackgroundingMethodBackgrounder && !input.fallbackToNative))
+            // NOTE: Must disable for Backgrounder method as well to prevent task-continuation
+            actions |= BGAppSetupDisableNative;
+    }
+
+    if (input.method == BGBackgroundingMethodBackgrounder)
+        actions |= BGAppSetupBackgrounderHooks;
+
+    return actions;
+}
+
+/* vim: set filetype=objcpp sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */
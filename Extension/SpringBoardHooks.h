@@ -3,7 +3,7 @@
  * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
  * Description: allow applications to run in the background
  * Author: Lance Fetters (aka. ashikase)
- * Last-modified: 2010-11-29 00:58:33
+ * Last-modified: 2026-10-17 22:58:59
  */
 
 /**
@@ -44,6 +44,8 @@
 
 // NOTE: These methods can be used by third-party extensions/applications
 @interface SpringBoard (Backgrounder)
+// NOTE: Has no effect if the app is not running, or if its backgrounding
+//       method is "Off".
 - (void)setBackgroundingEnabled:(BOOL)enable forDisplayIdentifier:(NSString *)identifier;
 @end
 
@@ -54,4 +56,8 @@
 - (void)cancelPreviousBackgrounderInvocation;
 @end
 
+// Record the time at which Backgrounder was invoked
+// NOTE: Used to measure the latency until the toggled app is suspended.
+void markBackgrounderInvocationTime();
+
 /* vim: set filetype=objcpp sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */
@@ -0,0 +1,276 @@
+/**
+ * Name: Backgrounder
+ * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
+ * Description: allow applications to run in the background
+ * Author: Lance Fetters (aka. ashikase)
+ * Last-modified: 2026-10-17 22:46:41
+ */
+
+/**
+ * Copyright (C) 2008-2010  Lance Fetters (aka. ashikase)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "StateJournal.h"
+
+#include <fcntl.h>
+#include <libkern/OSAtomic.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/sysctl.h>
+#include <unistd.h>
+
+#import "AppRegistry.h"
+#import "ControlBlock.h"
+
+#define kJournalFilePath "/var/mobile/Library/Caches/jp.ashikase.backgrounder.state"
+
+#define kJournalMagic 0x4a534742 // 'BGSJ'
+#define kJournalVersion 1
+
+// NOTE: More apps than this are unlikely to have state at once; any beyond
+//       the limit are simply not journaled.
+#define kJournalSlotCount 64
+
+// Only these states are journaled
+#define kJournaledStates (BGAppStateBackgroundingEnabled | BGAppStatePermittedToRelaunch)
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slotCount;
+    uint32_t reserved;
+} BGJournalHeader;
+
+// NOTE: A slot is in use if states is non-zero; states is always written
+//       last (and cleared first), so that a crash part-way through an update
+//       cannot leave a slot that appears valid but is not.
+// NOTE: The start time of the process guards against reuse of the pid.
+typedef struct {
+    volatile uint32_t states;
+    int32_t pid;
+    uint64_t startTime;
+    char displayId[112];
+} BGJournalSlot;
+
+typedef struct {
+    BGJournalHeader header;
+    BGJournalSlot slots[kJournalSlotCount];
+} BGJournal;
+
+static BGJournal *journal_ = NULL;
+
+//==============================================================================
+
+// NOTE: Returns zero if the process does not exist.
+static uint64_t startTimeForPid(pid_t pid)
+{
+    if (pid <= 0)
+        return 0;
+
+    struct kinfo_proc info;
+    size_t size = sizeof(info);
+    int mib[4] = {CTL_KERN, KERN_PROC, KERN_PROC_PID, pid};
+    if (sysctl(mib, 4, &info, &size, NULL, 0) != 0 || size == 0)
+        return 0;
+
+    const struct timeval &tv = info.kp_proc.p_starttime;
+    return (uint64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+static BGJournal *openJournal()
+{
+    int fd = open(kJournalFilePath, O_RDWR | O_CREAT, 0644);
+    if (fd == -1)
+        return NULL;
+
+    BGJournal *journal = NULL;
+    struct stat st;
+    if (fstat(fd, &st) == 0) {
+        bool isNew = (st.st_size != sizeof(BGJournal));
+        if (!isNew || (ftruncate(fd, 0) == 0 && ftruncate(fd, sizeof(BGJournal)) == 0)) {
+            void *addr = mmap(NULL, sizeof(BGJournal), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (addr != MAP_FAILED) {
+                journal = reinterpret_cast<BGJournal *>(addr);
+                if (journal->header.magic != kJournalMagic
+                        || journal->header.version != kJournalVersion
+                        || journal->header.slotCount != kJournalSlotCount) {
+                    // New, or written by an incompatible version; start over
+                    memset(journal, 0, sizeof(BGJournal));
+                    journal->header.magic = kJournalMagic;
+                    journal->header.version = kJournalVersion;
+                    journal->header.slotCount = kJournalSlotCount;
+                }
+            }
+        }
+    }
+    close(fd);
+
+    return journal;
+}
+
+static BGJournalSlot *slotForDisplayIdentifier(const char *displayId, bool create)
+{
+    BGJournalSlot *freeSlot = NULL;
+    for (unsigned i = 0; i < kJournalSlotCount; ++i) {
+        BGJournalSlot *slot = &journal_->slots[i];
+        if (slot->states == 0) {
+            if (freeSlot == NULL)
+                freeSlot = slot;
+        } else if (strncmp(slot->displayId, displayId, sizeof(slot->displayId)) == 0) {
+            return slot;
+        }
+    }
+    return create ? freeSlot : NULL;
+}
+
+static void writeSlot(BGJournalSlot *slot, const char *displayId, uint32_t states, pid_t pid, uint64_t startTime)
+{
+    // Invalidate the slot while it is being updated
+    slot->states = 0;
+    OSMemoryBarrier();
+
+    slot->pid = pid;
+    slot->startTime = startTime;
+    strlcpy(slot->displayId, displayId, sizeof(slot->displayId));
+    OSMemoryBarrier();
+
+    slot->states = states;
+}
+
+//==============================================================================
+
+NSArray *restoreJournaledAppStates()
+{
+    NSMutableArray *adopted = [NSMutableArray array];
+
+    if (journal_ == NULL)
+        journal_ = openJournal();
+    if (journal_ == NULL)
+        return adopted;
+
+    for (unsigned i = 0; i < kJournalSlotCount; ++i) {
+        BGJournalSlot *slot = &journal_->slots[i];
+        uint32_t states = slot->states & kJournaledStates;
+        if (states == 0) {
+            slot->states = 0;
+            continue;
+        }
+
+        if (states & BGAppStateBackgroundingEnabled) {
+            // Only keep for processes that survived the restart
+            bool alive = (slot->pid > 0 && slot->startTime != 0 && startTimeForPid(slot->pid) == slot->startTime);
+            if (alive) {
+                // The app may have been stopped by the throttler of the
+                // previous instance; never leave it stopped
+                // NOTE: Throttling is restarted when the app is re-adopted.
+                kill(slot->pid, SIGCONT);
+
+                // NOTE: If the app has a control block, its state is authoritative.
+                bool enabled;
+                if (peekControlBlockEnabled(slot->pid, &enabled) && !enabled)
+                    alive = false;
+            }
+            if (!alive)
+                states &= ~BGAppStateBackgroundingEnabled;
+        }
+
+        NSString *displayId = [[NSString alloc] initWithBytes:slot->displayId
+            length:strnlen(slot->displayId, sizeof(slot->displayId)) encoding:NSUTF8StringEncoding];
+        if (displayId != nil) {
+            if (states & BGAppStatePermittedToRelaunch)
+                setAppState(displayId, BGAppStatePermittedToRelaunch, YES);
+            if (states & BGAppStateBackgroundingEnabled) {
+                setAppState(displayId, BGAppStateBackgroundingEnabled, YES);
+                [adopted addObject:displayId];
+            }
+            [displayId release];
+        } else {
+            states = 0;
+        }
+
+        if (states == 0) {
+            // Nothing left to keep
+            slot->states = 0;
+        } else if (states != slot->states) {
+            // Process is gone
+            slot->states = 0;
+            OSMemoryBarrier();
+            slot->pid = 0;
+            slot->startTime = 0;
+            OSMemoryBarrier();
+            slot->states = states;
+        }
+    }
+
+    return adopted;
+}
+
+void journalAppState(NSString *displayId, pid_t pid)
+{
+    if (journal_ == NULL || displayId == nil)
+        return;
+
+    const char *name = [displayId UTF8String];
+    if (name == NULL || strlen(name) >= sizeof(journal_->slots[0].displayId))
+        return;
+
+    uint32_t states = 0;
+    if (appHasState(displayId, BGAppStateBackgroundingEnabled))
+        states |= BGAppStateBackgroundingEnabled;
+    if (appHasState(displayId, BGAppStatePermittedToRelaunch))
+        states |= BGAppStatePermittedToRelaunch;
+
+    BGJournalSlot *slot = slotForDisplayIdentifier(name, states != 0);
+    if (slot == NULL)
+        // Not journaled, and nothing to journal (or no free slot)
+        return;
+
+    if (states == 0) {
+        // Release the slot
+        slot->states = 0;
+        return;
+    }
+
+    if (pid <= 0 && slot->states != 0) {
+        // Keep the previously recorded process
+        if (slot->states != states)
+            slot->states = states;
+        return;
+    }
+
+    writeSlot(slot, name, states, pid, startTimeForPid(pid));
+}
+
+/* vim: set filetype=objcpp sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */
@@ -3,7 +3,7 @@
  * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
  * Description: allow applications to run in the background
  * Author: Lance Fetters (aka. ashikase)
- * Last-modified: 2010-11-29 00:21:10
+ * Last-modified: 2026-10-17 22:42:51
  */
 
 /**
@@ -40,23 +40,13 @@
  */
 
 
-#import "Headers.h"
+#include <stdint.h>
 
-#import <substrate.h>
-
-@interface BackgrounderAlertItem : SBAlertItem
-{
-    NSString *title;
-    NSString *message;
-}
-
-- (id)initWithTitle:(NSString *)title message:(NSString *)message;
-- (void)configure:(BOOL)configure requirePasscodeForActions:(BOOL)passcode;
-
-@end
-
-//______________________________________________________________________________
-
-void initSimplePopup();
+// Look up the address of an exported symbol in the given Mach-O file
+// NOTE: Each call maps the file and scans its symbol table; nothing is kept
+//       afterwards, as each process only makes one lookup.
+// NOTE: For Thumb functions, the low bit of the returned address is set.
+// NOTE: Returns 0 if the file or symbol could not be found.
+uintptr_t lookupSymbolAddress(const char *libraryFilePath, const char *symbolName);
 
 /* vim: set filetype=objcpp sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */
@@ -0,0 +1,193 @@
+/**
+ * Name: Backgrounder
+ * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
+ * Description: allow applications to run in the background
+ * Author: Lance Fetters (aka. ashikase)
+ * Last-modified: 2026-10-17 22:42:51
+ */
+
+/**
+ * Copyright (C) 2008-2010  Lance Fetters (aka. ashikase)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "SymbolResolver.h"
+
+#include <fcntl.h>
+#include <mach-o/arch.h>
+#include <mach-o/fat.h>
+#include <mach-o/loader.h>
+#include <mach-o/nlist.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <libkern/OSByteOrder.h>
+
+// Return the (thin) Mach-O image matching this process's architecture
+// NOTE: The size of the image is returned via imageSize.
+static const struct mach_header *findImage(const uint8_t *base, size_t size, size_t *imageSize)
+{
+    if (size < sizeof(struct mach_header))
+        return NULL;
+
+    uint32_t magic = *reinterpret_cast<const uint32_t *>(base);
+    if (magic == MH_MAGIC) {
+        *imageSize = size;
+        return reinterpret_cast<const struct mach_header *>(base);
+    }
+
+    if (magic == FAT_CIGAM || magic == FAT_MAGIC) {
+        // Universal binary; fat headers are always big-endian
+        const struct fat_header *fh = reinterpret_cast<const struct fat_header *>(base);
+        uint32_t nfat = OSSwapBigToHostInt32(fh->nfat_arch);
+        if (nfat > (size - sizeof(struct fat_header)) / sizeof(struct fat_arch))
+            return NULL;
+
+        struct fat_arch *archs = (struct fat_arch *)malloc(nfat * sizeof(struct fat_arch));
+        if (archs == NULL)
+            return NULL;
+        const struct fat_arch *src = reinterpret_cast<const struct fat_arch *>(fh + 1);
+        for (uint32_t i = 0; i < nfat; ++i) {
+            archs[i].cputype = OSSwapBigToHostInt32(src[i].cputype);
+            archs[i].cpusubtype = OSSwapBigToHostInt32(src[i].cpusubtype);
+            archs[i].offset = OSSwapBigToHostInt32(src[i].offset);
+            archs[i].size = OSSwapBigToHostInt32(src[i].size);
+            archs[i].align = OSSwapBigToHostInt32(src[i].align);
+        }
+
+        const struct mach_header *mh = NULL;
+        const NXArchInfo *local = NXGetLocalArchInfo();
+        const struct fat_arch *best = (local != NULL) ?
+            NXFindBestFatArch(local->cputype, local->cpusubtype, archs, nfat) : NULL;
+        if (best != NULL && best->offset <= size && best->size <= size - best->offset
+                && best->size >= sizeof(struct mach_header)) {
+            const uint8_t *image = base + best->offset;
+            if (*reinterpret_cast<const uint32_t *>(image) == MH_MAGIC) {
+                mh = reinterpret_cast<const struct mach_header *>(image);
+                *imageSize = best->size;
+            }
+        }
+        free(archs);
+        return mh;
+    }
+
+    return NULL;
+}
+
+// NOTE: All offsets and counts are read from the file, and so are checked
+//       against the size of the image before use.
+static uintptr_t findSymbol(const uint8_t *base, size_t size, const char *symbolName)
+{
+    size_t imageSize = 0;
+    const struct mach_header *mh = findImage(base, size, &imageSize);
+    if (mh == NULL)
+        return 0;
+
+    // Find the symbol table load command
+    const uint8_t *image = reinterpret_cast<const uint8_t *>(mh);
+    const struct symtab_command *symtab = NULL;
+    size_t offset = sizeof(struct mach_header);
+    for (uint32_t i = 0; i < mh->ncmds; ++i) {
+        if (imageSize - offset < sizeof(struct load_command))
+            break;
+        const struct load_command *lc = reinterpret_cast<const struct load_command *>(image + offset);
+        if (lc->cmdsize < sizeof(struct load_command) || lc->cmdsize > imageSize - offset)
+            break;
+        if (lc->cmd == LC_SYMTAB) {
+            if (lc->cmdsize >= sizeof(struct symtab_command))
+                symtab = reinterpret_cast<const struct symtab_command *>(lc);
+            break;
+        }
+        offset += lc->cmdsize;
+    }
+    if (symtab == NULL
+            || symtab->symoff > imageSize
+            || symtab->nsyms > (imageSize - symtab->symoff) / sizeof(struct nlist)
+            || symtab->stroff > imageSize
+            || symtab->strsize > imageSize - symtab->stroff)
+        return 0;
+
+    // Scan the defined symbols for the requested name
+    // NOTE: The name must fit within the string table, including its
+    //       terminating NUL.
+    const struct nlist *nl = reinterpret_cast<const struct nlist *>(image + symtab->symoff);
+    const char *strings = reinterpret_cast<const char *>(image + symtab->stroff);
+    size_t nameSize = strlen(symbolName) + 1;
+    for (uint32_t i = 0; i < symtab->nsyms; ++i) {
+        if ((nl[i].n_type & N_STAB) != 0 || (nl[i].n_type & N_TYPE) != N_SECT)
+            continue;
+        uint32_t strx = nl[i].n_un.n_strx;
+        if (strx == 0 || strx >= symtab->strsize || nameSize > symtab->strsize - strx)
+            continue;
+        if (memcmp(strings + strx, symbolName, nameSize) != 0)
+            continue;
+
+        // Check whether it is ARM or Thumb
+        uintptr_t address = nl[i].n_value;
+        if ((nl[i].n_desc & N_ARM_THUMB_DEF) != 0)
+            address |= 0x00000001;
+        return address;
+    }
+
+    return 0;
+}
+
+//==============================================================================
+
+uintptr_t lookupSymbolAddress(const char *libraryFilePath, const char *symbolName)
+{
+    int fd = open(libraryFilePath, O_RDONLY);
+    if (fd == -1)
+        return 0;
+
+    void *map = MAP_FAILED;
+    size_t size = 0;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        size = st.st_size;
+        map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (map == MAP_FAILED)
+        return 0;
+
+    // NOTE: Only the pages of the headers and of the symbol and string tables
+    //       are read; the mapping is released once the scan is done.
+    uintptr_t address = findSymbol(reinterpret_cast<const uint8_t *>(map), size, symbolName);
+    munmap(map, size);
+    return address;
+}
+
+/* vim: set filetype=objcpp sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */
@@ -0,0 +1,99 @@
+/**
+ * Name: Backgrounder
+ * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
+ * Description: allow applications to run in the background
+ * Author: Lance Fetters (aka. ashikase)
+ * Last-modified: 2026-10-17 10:12:45
+ */
+
+/**
+ * Copyright (C) 2008-2010  Lance Fetters (aka. ashikase)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef BG_THROTTLESCHEDULER_H
+#define BG_THROTTLESCHEDULER_H
+
+#include <sys/types.h>
+#include <vector>
+
+// Time-slices processes by stopping and resuming them on a duty cycle.
+// NOTE: This class does not read the clock; the current time (in seconds,
+//       from any monotonic origin) is passed in by the caller, which is
+//       expected to call fire() at (or shortly after) nextFireTime().
+// NOTE: Resume times are aligned to a grid shared by all processes with the
+//       same period, and events falling within the coalescing window are
+//       handled together, so that wakeups are batched.
+class ThrottleScheduler {
+    public:
+        ThrottleScheduler(double coalescingWindow = 0.1);
+        ~ThrottleScheduler();
+
+        // Start throttling; the process is left running for the first slice
+        void add(pid_t pid, double runDuration, double period, double now);
+
+        // Stop throttling; the process is resumed if currently stopped
+        void remove(pid_t pid);
+        void removeAll();
+
+        bool contains(pid_t pid) const;
+        bool isStopped(pid_t pid) const;
+        unsigned count() const { return entries_.size(); }
+
+        // Returns a negative value if there is nothing to schedule
+        double nextFireTime() const;
+
+        // Stop/resume all processes whose next event is due
+        // NOTE: Returns the number of processes signalled.
+        unsigned fire(double now);
+
+    private:
+        struct Entry {
+            pid_t pid;
+            double runDuration;
+            double period;
+            double nextEvent;
+            bool stopped;
+        };
+
+        std::vector<Entry> entries_;
+        double coalescingWindow_;
+        double epoch_;
+        bool hasEpoch_;
+
+        int indexOf(pid_t pid) const;
+        double nextResumeTime(double period, double now);
+};
+
+#endif // BG_THROTTLESCHEDULER_H
+
+/* vim: set filetype=objcpp sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */
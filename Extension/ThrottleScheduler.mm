@@ -0,0 +1,178 @@
+/**
+ * Name: Backgrounder
+ * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
+ * Description: allow applications to run in the background
+ * Author: Lance Fetters (aka. ashikase)
+ * Last-modified: 2026-10-17 10:12:45
+ */
+
+/**
+ * Copyright (C) 2008-2010  Lance Fetters (aka. ashikase)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "ThrottleScheduler.h"
+
+#include <math.h>
+#include <signal.h>
+
+// NOTE: This file intentionally uses only portable C++ and POSIX calls.
+
+ThrottleScheduler::ThrottleScheduler(double coalescingWindow)
+    : coalescingWindow_(coalescingWindow), epoch_(0), hasEpoch_(false)
+{
+}
+
+ThrottleScheduler::~ThrottleScheduler()
+{
+    // Never leave a process stopped
+    removeAll();
+}
+
+int ThrottleScheduler::indexOf(pid_t pid) const
+{
+    for (unsigned i = 0; i < entries_.size(); ++i)
+        if (entries_[i].pid == pid)
+            return i;
+    return -1;
+}
+
+double ThrottleScheduler::nextResumeTime(double period, double now)
+{
+    // Align to the shared grid so that processes resume together
+    double slots = floor((now - epoch_) / period) + 1.0;
+    return epoch_ + slots * period;
+}
+
+//==============================================================================
+
+void ThrottleScheduler::add(pid_t pid, double runDuration, double period, double now)
+{
+    if (pid <= 0 || runDuration <= 0 || period <= runDuration)
+        // Invalid or no-op duty cycle
+        return;
+
+    if (!hasEpoch_) {
+        epoch_ = now;
+        hasEpoch_ = true;
+    }
+
+    int index = indexOf(pid);
+    if (index == -1) {
+        Entry entry;
+        entry.pid = pid;
+        entries_.push_back(entry);
+        index = entries_.size() - 1;
+    } else if (entries_[index].stopped) {
+        kill(pid, SIGCONT);
+    }
+
+    Entry &entry = entries_[index];
+    entry.runDuration = runDuration;
+    entry.period = period;
+    entry.stopped = false;
+    entry.nextEvent = now + runDuration;
+}
+
+void ThrottleScheduler::remove(pid_t pid)
+{
+    int index = indexOf(pid);
+    if (index != -1) {
+        // NOTE: Resume unconditionally; harmless if not stopped
+        kill(pid, SIGCONT);
+        entries_.erase(entries_.begin() + index);
+    }
+}
+
+void ThrottleScheduler::removeAll()
+{
+    for (unsigned i = 0; i < entries_.size(); ++i)
+        kill(entries_[i].pid, SIGCONT);
+    entries_.clear();
+}
+
+bool ThrottleScheduler::contains(pid_t pid) const
+{
+    return indexOf(pid) != -1;
+}
+
+bool ThrottleScheduler::isStopped(pid_t pid) const
+{
+    int index = indexOf(pid);
+    return (index != -1) ? entries_[index].stopped : false;
+}
+
+double ThrottleScheduler::nextFireTime() const
+{
+    double ret = -1.0;
+    for (unsigned i = 0; i < entries_.size(); ++i)
+        if (ret < 0 || entries_[i].nextEvent < ret)
+            ret = entries_[i].nextEvent;
+    return ret;
+}
+
+unsigned ThrottleScheduler::fire(double now)
+{
+    unsigned signalled = 0;
+
+    double deadline = now + coalescingWindow_;
+    for (unsigned i = 0; i < entries_.size();) {
+        Entry &entry = entries_[i];
+        if (entry.nextEvent > deadline) {
+            ++i;
+            continue;
+        }
+
+        int signal = entry.stopped ? SIGCONT : SIGSTOP;
+        if (kill(entry.pid, signal) != 0) {
+            // Process no longer exists
+            entries_.erase(entries_.begin() + i);
+            continue;
+        }
+        ++signalled;
+
+        if (entry.stopped) {
+            // Resumed; run for one slice
+            entry.stopped = false;
+            entry.nextEvent = now + entry.runDuration;
+        } else {
+            // Stopped; resume at the next slot of the period
+            entry.stopped = true;
+            entry.nextEvent = nextResumeTime(entry.period, now);
+        }
+        ++i;
+    }
+
+    return signalled;
+}
+
+/* vim: set filetype=objcpp sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */
@@ -0,0 +1,94 @@
+/**
+ * Name: Backgrounder
+ * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
+ * Description: allow applications to run in the background
+ * Author: Lance Fetters (aka. ashikase)
+ * Last-modified: 2026-10-17 22:23:28
+ */
+
+/**
+ * Copyright (C) 2008-2010  Lance Fetters (aka. ashikase)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef BG_TIMERWHEEL_H
+#define BG_TIMERWHEEL_H
+
+#include <map>
+#include <vector>
+
+// Tracks a deadline for each of a set of keys, so that a single timer can
+// serve all of them.
+// NOTE: This class does not read the clock; the current time (in seconds,
+//       from any origin) is passed in by the caller, which is expected to
+//       call expire() at (or shortly after) nextFireTime().
+// NOTE: Deadlines are rounded up to the tick duration. Deadlines further
+//       away than one revolution of the wheel (tick duration multiplied by
+//       number of slots) may cause one spurious wakeup per revolution.
+class TimerWheel {
+    public:
+        TimerWheel(double tickDuration = 30.0, unsigned slotCount = 256);
+
+        // Replaces any existing deadline for the key
+        void schedule(unsigned key, double deadline, double now);
+        void cancel(unsigned key);
+        void cancelAll();
+
+        bool contains(unsigned key) const;
+        unsigned count() const { return index_.size(); }
+
+        // Returns a negative value if there is nothing to schedule
+        double nextFireTime() const;
+
+        // Remove all keys whose deadline has passed, appending them to expired
+        // NOTE: Returns the number of keys appended.
+        unsigned expire(double now, std::vector<unsigned> &expired);
+
+    private:
+        struct Entry {
+            unsigned key;
+            long long tick;
+        };
+
+        std::vector<std::vector<Entry> > slots_;
+        // NOTE: Maps each key to the tick of its deadline
+        std::map<unsigned, long long> index_;
+        double tickDuration_;
+        long long currentTick_;
+
+        long long tickForTime(double time) const;
+        void removeFromSlot(unsigned key, long long tick);
+};
+
+#endif // BG_TIMERWHEEL_H
+
+/* vim: set filetype=objcpp sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */
@@ -0,0 +1,166 @@
+/**
+ * Name: Backgrounder
+ * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
+ * Description: allow applications to run in the background
+ * Author: Lance Fetters (aka. ashikase)
+ * Last-modified: 2026-10-17 22:23:28
+ */
+
+/**
+ * Copyright (C) 2008-2010  Lance Fetters (aka. ashikase)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "TimerWheel.h"
+
+#include <math.h>
+
+// NOTE: This file intentionally uses only portable C++.
+
+TimerWheel::TimerWheel(double tickDuration, unsigned slotCount)
+    : slots_(slotCount > 0 ? slotCount : 1), tickDuration_(tickDuration), currentTick_(0)
+{
+}
+
+long long TimerWheel::tickForTime(double time) const
+{
+    return (long long)floor(time / tickDuration_);
+}
+
+void TimerWheel::removeFromSlot(unsigned key, long long tick)
+{
+    std::vector<Entry> &slot = slots_[tick % slots_.size()];
+    for (unsigned i = 0; i < slot.size(); ++i) {
+        if (slot[i].key == key) {
+            // NOTE: Order within a slot does not matter
+            slot[i] = slot.back();
+            slot.pop_back();
+            return;
+        }
+    }
+}
+
+//==============================================================================
+
+void TimerWheel::schedule(unsigned key, double deadline, double now)
+{
+    if (index_.empty())
+        // Nothing pending; safe to move the wheel to the current time
+        currentTick_ = tickForTime(now);
+
+    cancel(key);
+
+    // NOTE: Round up, so that a key never expires before its deadline
+    long long tick = (long long)ceil(deadline / tickDuration_);
+    if (tick <= currentTick_)
+        tick = currentTick_ + 1;
+
+    Entry entry;
+    entry.key = key;
+    entry.tick = tick;
+    slots_[tick % slots_.size()].push_back(entry);
+    index_[key] = tick;
+}
+
+void TimerWheel::cancel(unsigned key)
+{
+    std::map<unsigned, long long>::iterator it = index_.find(key);
+    if (it != index_.end()) {
+        removeFromSlot(key, it->second);
+        index_.erase(it);
+    }
+}
+
+void TimerWheel::cancelAll()
+{
+    for (unsigned i = 0; i < slots_.size(); ++i)
+        slots_[i].clear();
+    index_.clear();
+}
+
+bool TimerWheel::contains(unsigned key) const
+{
+    return index_.find(key) != index_.end();
+}
+
+double TimerWheel::nextFireTime() const
+{
+    if (index_.empty())
+        return -1.0;
+
+    // Find the first non-empty slot
+    // NOTE: Entries in that slot may belong to a later revolution; if so,
+    //       expire() will simply find nothing to do.
+    long long slotCount = slots_.size();
+    for (long long tick = currentTick_ + 1; tick <= currentTick_ + slotCount; ++tick)
+        if (!slots_[tick % slotCount].empty())
+            return tick * tickDuration_;
+
+    // NOTE: Should not be reached
+    return (currentTick_ + 1) * tickDuration_;
+}
+
+unsigned TimerWheel::expire(double now, std::vector<unsigned> &expired)
+{
+    unsigned count = 0;
+
+    long long nowTick = tickForTime(now);
+    if (nowTick <= currentTick_)
+        return 0;
+
+    // NOTE: Each slot need be visited at most once, however long it has been
+    //       since the last call.
+    long long slotCount = slots_.size();
+    long long firstTick = currentTick_ + 1;
+    if (nowTick - firstTick >= slotCount)
+        firstTick = nowTick - slotCount + 1;
+
+    for (long long tick = firstTick; tick <= nowTick; ++tick) {
+        std::vector<Entry> &slot = slots_[tick % slotCount];
+        for (unsigned i = 0; i < slot.size();) {
+            if (slot[i].tick <= nowTick) {
+                expired.push_back(slot[i].key);
+                index_.erase(slot[i].key);
+                slot[i] = slot.back();
+                slot.pop_back();
+                ++count;
+            } else {
+                ++i;
+            }
+        }
+    }
+
+    currentTick_ = nowTick;
+    return count;
+}
+
+/* vim: set filetype=objcpp sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */
@@ -45,6 +45,7 @@
 #include <notify.h>
 
 #import "Constants.h"
+#import "InstalledApplications.h"
 #import "Preferences.h"
 #import "RootController.h"
 
@@ -86,8 +87,17 @@
     [super dealloc];
 }
 
+- (void)applicationWillEnterForeground:(UIApplication *)application
+{
+    // Apps may have been installed or removed while in the background
+    invalidateInstalledApplications();
+}
+
 - (void)applicationWillTerminate:(UIApplication *)application
 {
+    // Write out any pending changes
+    [[Preferences sharedInstance] flushChanges];
+
     if ([[Preferences sharedInstance] needsRespring])
         // Respring SpringBoard
         system("/usr/bin/killall SpringBoard");
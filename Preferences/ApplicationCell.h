@@ -40,9 +40,14 @@
  */
 
 
-@interface ApplicationCell : UITableViewCell
+#import "IconCache.h"
+
+@interface ApplicationCell : UITableViewCell <IconCacheDelegate>
 {
     NSString *displayId;
+
+    // Pending request for this cell's icon, if any
+    id iconRequest;
 }
 
 @property(nonatomic, copy) NSString *displayId;
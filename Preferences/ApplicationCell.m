@@ -42,30 +42,20 @@
 
 #import "ApplicationCell.h"
 
-#include <dlfcn.h>
-
-// SpringBoardServices
-extern NSString * SBSCopyLocalizedApplicationNameForDisplayIdentifier(NSString *identifier);
-extern NSString * SBSCopyIconImagePathForDisplayIdentifier(NSString *identifier);
-
-// Firmware 4.x
-// NOTE: The SBS method actually returns CFData; taking advantage of toll-free bridging
-static BOOL isFirmware3x = NO;
-static NSData * (*SBSCopyIconImagePNGDataForDisplayIdentifier)(NSString *identifier) = NULL;
+#import "DisplayNames.h"
 
 
 @implementation ApplicationCell
 
 @synthesize displayId;
 
-+ (void)initialize
+- (void)dealloc
 {
-    // Determine firmware version
-    isFirmware3x = [[[UIDevice currentDevice] systemVersion] hasPrefix:@"3"];
-    if (!isFirmware3x) {
-        // Firmware >= 4.0
-        SBSCopyIconImagePNGDataForDisplayIdentifier = dlsym(RTLD_DEFAULT, "SBSCopyIconImagePNGDataForDisplayIdentifier");
-    }
+    [[IconCache sharedInstance] cancelRequest:iconRequest];
+    [iconRequest release];
+    [displayId release];
+
+    [super dealloc];
 }
 
 - (void)setDisplayId:(NSString *)identifier
@@ -74,32 +64,35 @@ static NSData * (*SBSCopyIconImagePNGDataForDisplayIdentifier)(NSString *identif
         [displayId release];
         displayId = [identifier copy];
 
-        NSString *displayName = SBSCopyLocalizedApplicationNameForDisplayIdentifier(identifier);
-        self.textLabel.text = displayName;
-        [displayName release];
-
-        UIImage *icon = nil;
-        if (isFirmware3x) {
-            // Firmware < 4.0
-            NSString *iconPath = SBSCopyIconImagePathForDisplayIdentifier(identifier);
-            if (iconPath != nil) {
-                icon = [UIImage imageWithContentsOfFile:iconPath];
-                [iconPath release];
-            }
-        } else {
-            // Firmware >= 4.0
-            if (SBSCopyIconImagePNGDataForDisplayIdentifier != NULL) {
-                NSData *data = (*SBSCopyIconImagePNGDataForDisplayIdentifier)(identifier);
-                if (data != nil) {
-                    icon = [UIImage imageWithData:data];
-                    [data release];
-                }
-            }
+        self.textLabel.text = displayNameForIdentifier(identifier);
+
+        // Cancel any request made for the previously displayed app
+        IconCache *cache = [IconCache sharedInstance];
+        [cache cancelRequest:iconRequest];
+        [iconRequest release];
+        iconRequest = nil;
+
+        // Show a placeholder until the icon has been loaded
+        UIImage *icon = [cache cachedIconForDisplayIdentifier:identifier];
+        if (icon == nil) {
+            icon = [IconCache placeholderIcon];
+            iconRequest = [[cache loadIconForDisplayIdentifier:identifier delegate:self] retain];
         }
         self.imageView.image = icon;
     }
 }
 
+- (void)iconCacheDidLoadIcon:(UIImage *)icon forDisplayIdentifier:(NSString *)identifier
+{
+    if ([identifier isEqualToString:displayId]) {
+        if (icon != nil)
+            self.imageView.image = icon;
+
+        [iconRequest release];
+        iconRequest = nil;
+    }
+}
+
 - (void)layoutSubviews
 {
     [super layoutSubviews];
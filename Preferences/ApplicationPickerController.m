@@ -43,12 +43,12 @@
 #import "ApplicationPickerController.h"
 
 #import "ApplicationCell.h"
+#import "DisplayNames.h"
+#import "InstalledApplications.h"
 #import "Preferences.h"
 
 // SpringBoardServices
-extern NSString * SBSCopyLocalizedApplicationNameForDisplayIdentifier(NSString *identifier);
 extern NSString * SBSCopyIconImagePathForDisplayIdentifier(NSString *identifier);
-extern NSArray * SBSCopyApplicationDisplayIdentifiers(BOOL activeOnly, BOOL unknown);
 
 @interface UIProgressHUD : UIView
 
@@ -61,63 +61,42 @@ extern NSArray * SBSCopyApplicationDisplayIdentifiers(BOOL activeOnly, BOOL unkn
 
 //==============================================================================
 
-static NSInteger compareDisplayNames(NSString *a, NSString *b, void *context)
-{
-    NSInteger ret;
-
-    NSString *name_a = SBSCopyLocalizedApplicationNameForDisplayIdentifier(a);
-    NSString *name_b = SBSCopyLocalizedApplicationNameForDisplayIdentifier(b);
-    ret = [name_a caseInsensitiveCompare:name_b];
-    [name_a release];
-    [name_b release];
-
-    return ret;
-}
-
-//==============================================================================
-
 static NSArray *applicationDisplayIdentifiers()
 {
-    // Get list of non-hidden applications
-    NSArray *nonhidden = SBSCopyApplicationDisplayIdentifiers(NO, NO);
-
-    // Get list of hidden applications (assuming LibHide is installed)
-    NSArray *hidden = nil;
-    NSString *filePath = [NSHomeDirectory() stringByAppendingPathComponent:@"Library/LibHide/hidden.plist"];
-    id value = [[NSDictionary dictionaryWithContentsOfFile:filePath] objectForKey:@"Hidden"];
-    if ([value isKindOfClass:[NSArray class]])
-        hidden = (NSArray *)value;
-
     // Record list of valid identifiers
     NSMutableArray *identifiers = [NSMutableArray array];
-    for (NSArray *array in [NSArray arrayWithObjects:nonhidden, hidden, nil]) {
-        for (NSString *identifier in array) {
-            // Filter out non-apps and apps that are not executed directly
-            // FIXME: Should Categories folders be in this list? Categories
-            //        folders are apps, but when used with CategoriesSB they are
-            //        non-apps.
-            if (identifier
-                    && ![identifier hasPrefix:@"jp.ashikase.springjumps."]
-                    && ![identifier isEqualToString:@"com.iptm.bigboss.sbsettings"]
-                    && ![identifier isEqualToString:@"com.apple.webapp"])
+    for (NSString *identifier in installedApplicationIdentifiers()) {
+        // Filter out non-apps and apps that are not executed directly
+        // FIXME: Should Categories folders be in this list? Categories
+        //        folders are apps, but when used with CategoriesSB they are
+        //        non-apps.
+        if (![identifier hasPrefix:@"jp.ashikase.springjumps."]
+                && ![identifier isEqualToString:@"com.iptm.bigboss.sbsettings"]
+                && ![identifier isEqualToString:@"com.apple.webapp"])
             [identifiers addObject:identifier];
-        }
     }
 
-    // Clean-up
-    [nonhidden release];
-
     return identifiers;
 }
 
 //==============================================================================
 
+// Number of applications sorted and added to the table at a time
+#define kEnumerationBatchSize 32
+
 // Create an array to cache the result of application enumeration
 // NOTE: Once created, this global will exist until program termination.
+// NOTE: Enumeration is performed in the background; the array is replaced (on
+//       the main thread) as each sorted batch is merged in.
 static NSArray *allApplications = nil;
+static BOOL enumerationStarted = NO;
+
+// The picker currently on screen, if any, to be updated as batches arrive
+static ApplicationPickerController *visiblePicker = nil;
 
 @interface ApplicationPickerController (Private)
-- (void)findAvailableItems;
+- (void)loadFilteredList;
+- (void)applicationsDidChange;
 @end
 
 @implementation ApplicationPickerController
@@ -170,6 +149,10 @@ static NSArray *allApplications = nil;
 
 - (void)dealloc
 {
+    if (visiblePicker == self)
+        visiblePicker = nil;
+
+    [busyIndicator hide];
     [busyIndicator release];
     [appsTableView release];
     [applications release];
@@ -177,6 +160,50 @@ static NSArray *allApplications = nil;
     [super dealloc];
 }
 
++ (void)enumerateApplicationsInBackground
+{
+    NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+
+    // Filter duplicate entries
+    // NOTE: This is necessary as libhide apparently does not prevent dupilcate entries
+    NSArray *identifiers = [[NSSet setWithArray:applicationDisplayIdentifiers()] allObjects];
+
+    // Sort in batches, handing each to the main thread as soon as it is ready
+    // NOTE: Display names are fetched (in parallel) once per identifier by
+    //       sortedByDisplayName(), and remain cached for merging.
+    NSUInteger count = [identifiers count];
+    for (NSUInteger i = 0; i < count; i += kEnumerationBatchSize) {
+        NSAutoreleasePool *batchPool = [[NSAutoreleasePool alloc] init];
+        NSArray *batch = [identifiers subarrayWithRange:NSMakeRange(i, MIN(kEnumerationBatchSize, count - i))];
+        [self performSelectorOnMainThread:@selector(addApplications:)
+            withObject:sortedByDisplayName(batch) waitUntilDone:NO];
+        [batchPool release];
+    }
+
+    // Ensure the list is created (and the progress indicator removed) even if
+    // no applications were found
+    [self performSelectorOnMainThread:@selector(addApplications:)
+        withObject:[NSArray array] waitUntilDone:NO];
+
+    [pool release];
+}
+
++ (void)addApplications:(NSArray *)sortedApplications
+{
+    if (allApplications == nil) {
+        allApplications = [sortedApplications retain];
+    } else if ([sortedApplications count] != 0) {
+        NSArray *merged = mergeSortedByDisplayName(allApplications, sortedApplications);
+        [allApplications release];
+        allApplications = [merged retain];
+    } else {
+        // Nothing to add
+        return;
+    }
+
+    [visiblePicker applicationsDidChange];
+}
+
 - (void)loadFilteredList
 {
     [applications release];
@@ -184,20 +211,8 @@ static NSArray *allApplications = nil;
     [applications removeObjectsInArray:[[[Preferences sharedInstance] objectForKey:kOverrides] allKeys]];
 }
 
-- (void)enumerateApplications
+- (void)applicationsDidChange
 {
-    // Get list of identifiers, store in set to filter duplicate entries
-
-    // Filter duplicate entries
-    // NOTE: This is necessary as libhide apparently does not prevent dupilcate entries
-    NSSet *set = [NSSet setWithArray:applicationDisplayIdentifiers()];
-
-    // Sort the list of identifiers by display name
-    NSArray *sortedArray = [[set allObjects] sortedArrayUsingFunction:compareDisplayNames context:NULL];
-
-    // Store the sorted list of identifiers
-    allApplications = [sortedArray retain];
-
     // Load the list and reload the table
     [self loadFilteredList];
     [appsTableView reloadData];
@@ -210,11 +225,13 @@ static NSArray *allApplications = nil;
 
 - (void)viewWillAppear:(BOOL)animated
 {
+    visiblePicker = self;
+
     // Reset the table by deselecting the current selection
     [appsTableView deselectRowAtIndexPath:[appsTableView indexPathForSelectedRow] animated:YES];
 
     if (allApplications != nil) {
-        // Application list already loaded
+        // Application list already (at least partially) loaded
         [self loadFilteredList];
         [appsTableView reloadData];
     }
@@ -222,20 +239,26 @@ static NSArray *allApplications = nil;
 
 - (void)viewDidAppear:(BOOL)animated
 {
-    // NOTE: The initial list is loaded after the view appears for style considerations.
-    // FIXME: Show busy indicator *before* the view appears.
     if (allApplications == nil) {
-        // Show a progress indicator
+        // Show a progress indicator until the first batch arrives
         busyIndicator = [[UIProgressHUD alloc] initWithWindow:[[UIApplication sharedApplication] keyWindow]];
         [busyIndicator setText:@"Loading applications..."];
         [busyIndicator show:YES];
 
-        // Enumerate applications
-        // NOTE: Must call via performSelector, or busy indicator does not show in time
-        [self performSelector:@selector(enumerateApplications) withObject:nil afterDelay:0.1f];
+        if (!enumerationStarted) {
+            // Enumerate applications
+            enumerationStarted = YES;
+            [[self class] performSelectorInBackground:@selector(enumerateApplicationsInBackground) withObject:nil];
+        }
     }
 }
 
+- (void)viewWillDisappear:(BOOL)animated
+{
+    if (visiblePicker == self)
+        visiblePicker = nil;
+}
+
 #pragma mark - UITableViewDataSource
 
 - (int)numberOfSectionsInTableView:(UITableView *)tableView
@@ -0,0 +1,219 @@
+/**
+ * Name: Backgrounder
+ * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
+ * Description: allow applications to run in the background
+ * Author: Lance Fetters (aka. ashikase)
+ * Last-modified: 2026-10-17 10:12:45
+ */
+
+/**
+ * Copyright (C) 2008-2010  Lance Fetters (aka. ashikase)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "DisplayNames.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+
+// SpringBoardServices
+extern NSString * SBSCopyLocalizedApplicationNameForDisplayIdentifier(NSString *identifier);
+
+// Number of threads (and identifiers per thread) used when fetching names
+#define kLookupConcurrency 4
+#define kLookupBatchSize 16
+
+// Cached names and collation keys, keyed by display identifier
+// NOTE: NSNull is stored for apps that have no name.
+static NSMutableDictionary *names_ = nil;
+static NSMutableDictionary *keys_ = nil;
+static pthread_mutex_t lock_ = PTHREAD_MUTEX_INITIALIZER;
+
+//==============================================================================
+
+static void cacheName(NSString *displayId, NSString *name)
+{
+    // NOTE: Comparing lowercase keys is equivalent to a case-insensitive
+    //       compare of display names.
+    NSString *key = (name != nil) ? [name lowercaseString] : @"";
+
+    pthread_mutex_lock(&lock_);
+    if (names_ == nil) {
+        names_ = [[NSMutableDictionary alloc] init];
+        keys_ = [[NSMutableDictionary alloc] init];
+    }
+    [names_ setObject:((name != nil) ? (id)name : (id)[NSNull null]) forKey:displayId];
+    [keys_ setObject:key forKey:displayId];
+    pthread_mutex_unlock(&lock_);
+}
+
+static id cachedValue(NSDictionary *dict, NSString *displayId)
+{
+    pthread_mutex_lock(&lock_);
+    id value = [[dict objectForKey:displayId] retain];
+    pthread_mutex_unlock(&lock_);
+    return [value autorelease];
+}
+
+static NSString *fetchName(NSString *displayId)
+{
+    NSString *name = SBSCopyLocalizedApplicationNameForDisplayIdentifier(displayId);
+    cacheName(displayId, name);
+    return [name autorelease];
+}
+
+NSString *displayNameForIdentifier(NSString *displayId)
+{
+    if (displayId == nil)
+        return nil;
+
+    id name = cachedValue(names_, displayId);
+    if (name == nil)
+        return fetchName(displayId);
+    return (name != [NSNull null]) ? name : nil;
+}
+
+static NSString *collationKey(NSString *displayId)
+{
+    NSString *key = cachedValue(keys_, displayId);
+    if (key == nil) {
+        fetchName(displayId);
+        key = cachedValue(keys_, displayId);
+    }
+    return key;
+}
+
+//==============================================================================
+
+@interface DisplayNameLoader : NSObject
+@end
+
+@implementation DisplayNameLoader
+
++ (void)loadBatch:(NSArray *)batch
+{
+    NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+    for (NSString *displayId in batch)
+        if (cachedValue(names_, displayId) == nil)
+            fetchName(displayId);
+    [pool release];
+}
+
+@end
+
+void loadDisplayNamesForIdentifiers(NSArray *identifiers)
+{
+    NSUInteger count = [identifiers count];
+    if (count <= kLookupBatchSize) {
+        [DisplayNameLoader loadBatch:identifiers];
+        return;
+    }
+
+    NSOperationQueue *queue = [[NSOperationQueue alloc] init];
+    [queue setMaxConcurrentOperationCount:kLookupConcurrency];
+    for (NSUInteger i = 0; i < count; i += kLookupBatchSize) {
+        NSArray *batch = [identifiers subarrayWithRange:NSMakeRange(i, MIN(kLookupBatchSize, count - i))];
+        NSInvocationOperation *operation = [[NSInvocationOperation alloc]
+            initWithTarget:[DisplayNameLoader class] selector:@selector(loadBatch:) object:batch];
+        [queue addOperation:operation];
+        [operation release];
+    }
+    [queue waitUntilAllOperationsAreFinished];
+    [queue release];
+}
+
+//==============================================================================
+
+typedef struct {
+    NSString *key;
+    NSString *displayId;
+} SortEntry;
+
+static int compareSortEntries(const void *a, const void *b)
+{
+    return [((const SortEntry *)a)->key compare:((const SortEntry *)b)->key];
+}
+
+NSArray *sortedByDisplayName(NSArray *identifiers)
+{
+    NSUInteger count = [identifiers count];
+    if (count == 0)
+        return [NSArray array];
+
+    loadDisplayNamesForIdentifiers(identifiers);
+
+    // Look up each collation key once, then sort
+    SortEntry *entries = (SortEntry *)malloc(count * sizeof(SortEntry));
+    NSUInteger i = 0;
+    for (NSString *displayId in identifiers) {
+        entries[i].key = collationKey(displayId);
+        entries[i].displayId = displayId;
+        i++;
+    }
+    qsort(entries, count, sizeof(SortEntry), compareSortEntries);
+
+    NSMutableArray *result = [NSMutableArray arrayWithCapacity:count];
+    for (i = 0; i < count; i++)
+        [result addObject:entries[i].displayId];
+    free(entries);
+
+    return result;
+}
+
+NSArray *mergeSortedByDisplayName(NSArray *a, NSArray *b)
+{
+    NSUInteger countA = [a count], countB = [b count];
+    NSMutableArray *result = [NSMutableArray arrayWithCapacity:(countA + countB)];
+
+    NSUInteger i = 0, j = 0;
+    NSString *keyA = (countA != 0) ? collationKey([a objectAtIndex:0]) : nil;
+    NSString *keyB = (countB != 0) ? collationKey([b objectAtIndex:0]) : nil;
+    while (i < countA && j < countB) {
+        if ([keyA compare:keyB] != NSOrderedDescending) {
+            [result addObject:[a objectAtIndex:i++]];
+            if (i < countA)
+                keyA = collationKey([a objectAtIndex:i]);
+        } else {
+            [result addObject:[b objectAtIndex:j++]];
+            if (j < countB)
+                keyB = collationKey([b objectAtIndex:j]);
+        }
+    }
+    if (i < countA)
+        [result addObjectsFromArray:[a subarrayWithRange:NSMakeRange(i, countA - i)]];
+    if (j < countB)
+        [result addObjectsFromArray:[b subarrayWithRange:NSMakeRange(j, countB - j)]];
+
+    return result;
+}
+
+/* vim: set filetype=objc sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */
@@ -124,8 +124,8 @@
 - (void)tableView:(UITableView *)tableView didSelectRowAtIndexPath:(NSIndexPath *)indexPath
 {
     static NSString *fileNames[][3] = {
-        {@"about.mdwn", @"usage.mdwn", @"faq.mdwn"},
-        {@"release_notes.mdwn", @"known_issues.mdwn", @"todo.mdwn"}};
+        {@"about.html", @"usage.html", @"faq.html"},
+        {@"release_notes.html", @"known_issues.html", @"todo.html"}};
 
     if (indexPath.section == 2) {
         // Project Homepage
@@ -135,7 +135,7 @@
 
         // NOTE: Controller is released in delegate callback
         HtmlDocController *docCont = [[HtmlDocController alloc]
-            initWithContentsOfFile:fileNames[indexPath.section][indexPath.row] templateFile:@"template.html" title:cell.textLabel.text];
+            initWithContentsOfFile:fileNames[indexPath.section][indexPath.row] title:cell.textLabel.text];
         docCont.delegate = self;
     }
 }
@@ -47,13 +47,14 @@
     id<HtmlDocControllerDelegate> delegate;
 
     NSString *fileName;
-    NSString *templateFileName;
     UIWebView *webView;
 }
 
 @property(nonatomic, assign) id<HtmlDocControllerDelegate> delegate;
 
-- (id)initWithContentsOfFile:(NSString *)fileName templateFile:(NSString *)templateFileName title:(NSString *)title;
+// NOTE: Documentation is converted to HTML at build time; fileName is the name
+//       of an HTML file in the documentation directory.
+- (id)initWithContentsOfFile:(NSString *)fileName title:(NSString *)title;
 
 @end
 
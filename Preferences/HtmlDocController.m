@@ -45,28 +45,16 @@
 #import "Constants.h"
 
 
-static NSString * contentsOfFile(NSString *path, NSString *name)
-{
-    NSStringEncoding encoding;
-    NSError *error = nil;
-    return [NSString stringWithContentsOfFile:
-        [NSString stringWithFormat:@"%@/%@", path, name]
-        usedEncoding:&encoding error:&error];
-}
-
-//==============================================================================
-
 @implementation HtmlDocController
 
 @synthesize delegate;
 
-- (id)initWithContentsOfFile:(NSString *)fileName_ templateFile:(NSString *)templateFileName_ title:(NSString *)title
+- (id)initWithContentsOfFile:(NSString *)fileName_ title:(NSString *)title
 {
     self = [super initWithNibName:nil bundle:nil];
     if (self) {
         self.title = title;
         fileName = [fileName_ copy];
-        templateFileName = [templateFileName_ copy];
 
         // NOTE: Using CGRectZero as initial size causes page layout issues
         CGSize size = [[UIScreen mainScreen] applicationFrame].size;
@@ -123,7 +111,6 @@ static NSString * contentsOfFile(NSString *path, NSString *name)
 - (void)dealloc
 {
     [webView release];
-    [templateFileName release];
     [fileName release];
 
     [super dealloc];
@@ -133,34 +120,16 @@ static NSString * contentsOfFile(NSString *path, NSString *name)
 
 - (void)loadFile
 {
-    NSString *filePath = nil;
-    NSString *content = nil;
-
-    if (fileName) {
-        // Try loading the specified file
-        filePath = [NSString stringWithFormat:@"%@/%@",
-                 [[NSBundle mainBundle] bundlePath], @DOC_BUNDLE_PATH];
-        content = contentsOfFile(filePath, fileName);
-
-        if (content == nil)
-            // Set an error message
-            content = @"<div style=\"text-align:center;\">(404: File not found)</div>";
-    }
+    NSString *filePath = [[[NSBundle mainBundle] bundlePath] stringByAppendingPathComponent:@DOC_BUNDLE_PATH];
+    filePath = [filePath stringByAppendingPathComponent:fileName];
 
-    if (templateFileName) {
-        NSString *template = contentsOfFile(filePath, templateFileName);
-        if (template) {
-            // Escape double-quotes and new-lines
-            // FIXME: If content is HTML, not always necessary (will affect attributes)
-            content = [content stringByReplacingOccurrencesOfString:@"\"" withString:@"\\\""];
-            content = [content stringByReplacingOccurrencesOfString:@"\n" withString:@"\\n"];
-
-            // Add content string to template
-            content = [template stringByReplacingOccurrencesOfString:@"<PLACEHOLDER>" withString:content];
-        }
+    if ([[NSFileManager defaultManager] fileExistsAtPath:filePath]) {
+        // Load the pre-rendered page directly
+        [webView loadRequest:[NSURLRequest requestWithURL:[NSURL fileURLWithPath:filePath]]];
+    } else {
+        // Show an error message
+        [webView loadHTMLString:@"<div style=\"text-align:center;\">(404: File not found)</div>" baseURL:nil];
     }
-
-    [webView loadHTMLString:content baseURL:[NSURL fileURLWithPath:filePath isDirectory:YES]];
 }
 
 #pragma mark - UIWebView delegate methods
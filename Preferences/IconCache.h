@@ -0,0 +1,72 @@
+/**
+ * Name: Backgrounder
+ * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
+ * Description: allow applications to run in the background
+ * Author: Lance Fetters (aka. ashikase)
+ * Last-modified: 2026-10-17 11:02:17
+ */
+
+/**
+ * Copyright (C) 2008-2010  Lance Fetters (aka. ashikase)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+@protocol IconCacheDelegate <NSObject>
+- (void)iconCacheDidLoadIcon:(UIImage *)icon forDisplayIdentifier:(NSString *)displayId;
+@end
+
+@interface IconCache : NSObject
+{
+    // Queue for loading, decoding and resizing icons
+    NSOperationQueue *queue;
+
+    // Recently used thumbnails, keyed by display identifier
+    // NOTE: Identifiers in lruOrder are ordered from least to most recent.
+    NSMutableDictionary *icons;
+    NSMutableArray *lruOrder;
+}
+
++ (IconCache *)sharedInstance;
++ (UIImage *)placeholderIcon;
+
+// Return the thumbnail for the given app if it is in memory, or nil
+- (UIImage *)cachedIconForDisplayIdentifier:(NSString *)displayId;
+
+// Load the thumbnail for the given app in the background; the delegate is
+// messaged on the main thread unless the returned request is cancelled
+// NOTE: The delegate is not retained.
+- (id)loadIconForDisplayIdentifier:(NSString *)displayId delegate:(id<IconCacheDelegate>)delegate;
+- (void)cancelRequest:(id)request;
+
+@end
+
+/* vim: set filetype=objc sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */
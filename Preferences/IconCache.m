@@ -0,0 +1,393 @@
+/**
+ * Name: Backgrounder
+ * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
+ * Description: allow applications to run in the background
+ * Author: Lance Fetters (aka. ashikase)
+ * Last-modified: 2026-10-17 11:02:17
+ */
+
+/**
+ * Copyright (C) 2008-2010  Lance Fetters (aka. ashikase)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "IconCache.h"
+
+#include <dlfcn.h>
+#include <sys/stat.h>
+
+// SpringBoardServices
+extern NSString * SBSCopyIconImagePathForDisplayIdentifier(NSString *identifier);
+
+// Firmware 4.x
+// NOTE: The SBS method actually returns CFData; taking advantage of toll-free bridging
+static BOOL isFirmware3x = NO;
+static NSData * (*SBSCopyIconImagePNGDataForDisplayIdentifier)(NSString *identifier) = NULL;
+static NSString * (*SBSCopyBundlePathForDisplayIdentifier)(NSString *identifier) = NULL;
+
+// Size (in points) at which ApplicationCell displays icons
+#define kIconSize 36.0f
+
+#define kMemoryCacheCapacity 64
+#define kLoadConcurrency 2
+
+// On-disk thumbnail format
+// NOTE: Pixels are stored in native (premultiplied BGRA) format so that cached
+//       thumbnails can be drawn without decoding.
+#define kThumbnailMagic 0x42474931
+typedef struct {
+    uint32_t magic;
+    uint32_t width;
+    uint32_t height;
+    uint32_t reserved;
+    int64_t mtime;
+} ThumbnailHeader;
+
+static CGFloat screenScale = 1.0f;
+static NSString *cacheDirectory = nil;
+
+//==============================================================================
+
+static NSString *thumbnailPath(NSString *displayId)
+{
+    return [cacheDirectory stringByAppendingPathComponent:[displayId stringByAppendingPathExtension:@"icon"]];
+}
+
+static int64_t iconModificationTime(NSString *displayId)
+{
+    // NOTE: The app bundle is rewritten whenever the app (and thus possibly
+    //       its icon) is installed or updated.
+    NSString *path = nil;
+    if (SBSCopyBundlePathForDisplayIdentifier != NULL)
+        path = (*SBSCopyBundlePathForDisplayIdentifier)(displayId);
+    if (path == nil)
+        path = SBSCopyIconImagePathForDisplayIdentifier(displayId);
+
+    int64_t mtime = 0;
+    struct stat st;
+    if (path != nil && stat([path fileSystemRepresentation], &st) == 0)
+        mtime = st.st_mtime;
+    [path release];
+
+    return mtime;
+}
+
+static CGImageRef createImageFromThumbnailFile(NSString *path, int64_t mtime)
+{
+    NSData *data = [NSData dataWithContentsOfFile:path];
+    if ([data length] < sizeof(ThumbnailHeader))
+        return NULL;
+
+    const ThumbnailHeader *header = (const ThumbnailHeader *)[data bytes];
+    size_t length = header->width * header->height * 4;
+    if (header->magic != kThumbnailMagic || header->mtime != mtime
+            || [data length] != sizeof(ThumbnailHeader) + length)
+        return NULL;
+
+    CFDataRef pixels = CFDataCreate(NULL, (const UInt8 *)[data bytes] + sizeof(ThumbnailHeader), length);
+    CGDataProviderRef provider = CGDataProviderCreateWithCFData(pixels);
+    CFRelease(pixels);
+
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGImageRef image = CGImageCreate(header->width, header->height, 8, 32, header->width * 4, colorSpace,
+        kCGImageAlphaPremultipliedFirst | kCGBitmapByteOrder32Little, provider, NULL, false,
+        kCGRenderingIntentDefault);
+    CGColorSpaceRelease(colorSpace);
+    CGDataProviderRelease(provider);
+
+    return image;
+}
+
+static NSData *copyIconData(NSString *displayId)
+{
+    NSData *data = nil;
+    if (isFirmware3x) {
+        // Firmware < 4.0
+        NSString *iconPath = SBSCopyIconImagePathForDisplayIdentifier(displayId);
+        if (iconPath != nil) {
+            data = [[NSData alloc] initWithContentsOfFile:iconPath];
+            [iconPath release];
+        }
+    } else {
+        // Firmware >= 4.0
+        if (SBSCopyIconImagePNGDataForDisplayIdentifier != NULL)
+            data = (*SBSCopyIconImagePNGDataForDisplayIdentifier)(displayId);
+    }
+    return data;
+}
+
+// Decode and downsize the given icon, writing the result to the given path
+// NOTE: Only CoreGraphics is used here, as UIKit drawing is not thread-safe on
+//       older firmware.
+static CGImageRef createThumbnail(NSData *iconData, NSString *path, int64_t mtime)
+{
+    CGDataProviderRef provider = CGDataProviderCreateWithCFData((CFDataRef)iconData);
+    CGImageRef source = CGImageCreateWithPNGDataProvider(provider, NULL, false, kCGRenderingIntentDefault);
+    CGDataProviderRelease(provider);
+    if (source == NULL)
+        return NULL;
+
+    size_t size = (size_t)(kIconSize * screenScale);
+    NSMutableData *data = [NSMutableData dataWithLength:(sizeof(ThumbnailHeader) + size * size * 4)];
+    ThumbnailHeader *header = (ThumbnailHeader *)[data mutableBytes];
+    header->magic = kThumbnailMagic;
+    header->width = size;
+    header->height = size;
+    header->mtime = mtime;
+
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef context = CGBitmapContextCreate((UInt8 *)[data mutableBytes] + sizeof(ThumbnailHeader),
+        size, size, 8, size * 4, colorSpace, kCGImageAlphaPremultipliedFirst | kCGBitmapByteOrder32Little);
+    CGColorSpaceRelease(colorSpace);
+
+    // Draw the icon, scaled to fit
+    CGFloat width = CGImageGetWidth(source);
+    CGFloat height = CGImageGetHeight(source);
+    CGFloat scale = MIN(size / width, size / height);
+    width *= scale;
+    height *= scale;
+    CGContextSetInterpolationQuality(context, kCGInterpolationHigh);
+    CGContextDrawImage(context, CGRectMake((size - width) / 2.0f, (size - height) / 2.0f, width, height), source);
+    CGImageRelease(source);
+
+    CGImageRef thumbnail = CGBitmapContextCreateImage(context);
+    CGContextRelease(context);
+
+    // Save for subsequent launches
+    // NOTE: Without a modification time there is no way to tell if the saved
+    //       thumbnail is stale.
+    if (mtime != 0)
+        [data writeToFile:path atomically:YES];
+
+    return thumbnail;
+}
+
+//==============================================================================
+
+@interface IconCache (Private)
+- (void)addIcon:(UIImage *)icon forDisplayIdentifier:(NSString *)displayId;
+@end
+
+@interface IconLoadOperation : NSOperation
+{
+    NSString *displayId;
+    id<IconCacheDelegate> delegate;
+    CGImageRef thumbnail;
+}
+
+- (id)initWithDisplayIdentifier:(NSString *)displayId delegate:(id<IconCacheDelegate>)delegate;
+
+@end
+
+@implementation IconLoadOperation
+
+- (id)initWithDisplayIdentifier:(NSString *)displayId_ delegate:(id<IconCacheDelegate>)delegate_
+{
+    self = [super init];
+    if (self) {
+        displayId = [displayId_ copy];
+        delegate = delegate_;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    CGImageRelease(thumbnail);
+    [displayId release];
+    [super dealloc];
+}
+
+- (void)main
+{
+    NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+
+    // NOTE: Requests are commonly cancelled while queued, as cells are reused
+    //       while scrolling.
+    if (![self isCancelled]) {
+        int64_t mtime = iconModificationTime(displayId);
+        NSString *path = thumbnailPath(displayId);
+
+        // Try the on-disk cache first
+        if (mtime != 0)
+            thumbnail = createImageFromThumbnailFile(path, mtime);
+
+        if (thumbnail == NULL && ![self isCancelled]) {
+            NSData *data = copyIconData(displayId);
+            if (data != nil) {
+                thumbnail = createThumbnail(data, path, mtime);
+                [data release];
+            }
+        }
+
+        // NOTE: The result is cached even if the request has been cancelled in
+        //       the meantime.
+        [self performSelectorOnMainThread:@selector(didFinishLoading) withObject:nil waitUntilDone:NO];
+    }
+
+    [pool release];
+}
+
+- (void)didFinishLoading
+{
+    UIImage *icon = nil;
+    if (thumbnail != NULL) {
+        icon = isFirmware3x ? [UIImage imageWithCGImage:thumbnail] :
+            [UIImage imageWithCGImage:thumbnail scale:screenScale orientation:UIImageOrientationUp];
+        [[IconCache sharedInstance] addIcon:icon forDisplayIdentifier:displayId];
+    }
+
+    // NOTE: Cancellation happens on the main thread, so checking here is
+    //       sufficient to ensure that the delegate is still valid.
+    if (![self isCancelled])
+        [delegate iconCacheDidLoadIcon:icon forDisplayIdentifier:displayId];
+}
+
+@end
+
+//==============================================================================
+
+@implementation IconCache
+
++ (void)initialize
+{
+    // Determine firmware version
+    isFirmware3x = [[[UIDevice currentDevice] systemVersion] hasPrefix:@"3"];
+    if (!isFirmware3x) {
+        // Firmware >= 4.0
+        SBSCopyIconImagePNGDataForDisplayIdentifier = dlsym(RTLD_DEFAULT, "SBSCopyIconImagePNGDataForDisplayIdentifier");
+        screenScale = [[UIScreen mainScreen] scale];
+    }
+    SBSCopyBundlePathForDisplayIdentifier = dlsym(RTLD_DEFAULT, "SBSCopyBundlePathForDisplayIdentifier");
+
+    // Create directory for storing thumbnails
+    cacheDirectory = [[NSHomeDirectory() stringByAppendingPathComponent:@"Library/Caches/"APP_ID"/Icons"] retain];
+    [[NSFileManager defaultManager] createDirectoryAtPath:cacheDirectory
+        withIntermediateDirectories:YES attributes:nil error:NULL];
+}
+
++ (IconCache *)sharedInstance
+{
+    static IconCache *instance = nil;
+    if (instance == nil)
+        instance = [[IconCache alloc] init];
+    return instance;
+}
+
++ (UIImage *)placeholderIcon
+{
+    // NOTE: A blank image is used so that cell layout does not change when the
+    //       actual icon is swapped in.
+    static UIImage *placeholder = nil;
+    if (placeholder == nil) {
+        UIGraphicsBeginImageContext(CGSizeMake(kIconSize, kIconSize));
+        placeholder = [UIGraphicsGetImageFromCurrentImageContext() retain];
+        UIGraphicsEndImageContext();
+    }
+    return placeholder;
+}
+
+- (id)init
+{
+    self = [super init];
+    if (self) {
+        queue = [[NSOperationQueue alloc] init];
+        [queue setMaxConcurrentOperationCount:kLoadConcurrency];
+
+        icons = [[NSMutableDictionary alloc] initWithCapacity:kMemoryCacheCapacity];
+        lruOrder = [[NSMutableArray alloc] initWithCapacity:kMemoryCacheCapacity];
+
+        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(didReceiveMemoryWarning:)
+            name:UIApplicationDidReceiveMemoryWarningNotification object:nil];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+
+    [queue cancelAllOperations];
+    [queue release];
+    [icons release];
+    [lruOrder release];
+
+    [super dealloc];
+}
+
+- (void)didReceiveMemoryWarning:(NSNotification *)notification
+{
+    // NOTE: Thumbnails remain available from the on-disk cache.
+    [icons removeAllObjects];
+    [lruOrder removeAllObjects];
+}
+
+- (UIImage *)cachedIconForDisplayIdentifier:(NSString *)displayId
+{
+    UIImage *icon = [icons objectForKey:displayId];
+    if (icon != nil) {
+        // Mark as most recently used
+        [lruOrder removeObject:displayId];
+        [lruOrder addObject:displayId];
+    }
+    return icon;
+}
+
+- (void)addIcon:(UIImage *)icon forDisplayIdentifier:(NSString *)displayId
+{
+    if ([icons objectForKey:displayId] != nil)
+        [lruOrder removeObject:displayId];
+    else if ([lruOrder count] == kMemoryCacheCapacity) {
+        // Evict least recently used
+        [icons removeObjectForKey:[lruOrder objectAtIndex:0]];
+        [lruOrder removeObjectAtIndex:0];
+    }
+
+    [icons setObject:icon forKey:displayId];
+    [lruOrder addObject:displayId];
+}
+
+- (id)loadIconForDisplayIdentifier:(NSString *)displayId delegate:(id<IconCacheDelegate>)delegate
+{
+    IconLoadOperation *operation = [[IconLoadOperation alloc] initWithDisplayIdentifier:displayId delegate:delegate];
+    [queue addOperation:operation];
+    return [operation autorelease];
+}
+
+- (void)cancelRequest:(id)request
+{
+    [(IconLoadOperation *)request cancel];
+}
+
+@end
+
+/* vim: set filetype=objc sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */
@@ -0,0 +1,224 @@
+/**
+ * Name: Backgrounder
+ * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
+ * Description: allow applications to run in the background
+ * Author: Lance Fetters (aka. ashikase)
+ * Last-modified: 2026-10-17 11:38:52
+ */
+
+/**
+ * Copyright (C) 2008-2010  Lance Fetters (aka. ashikase)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "InstalledApplications.h"
+
+#include <pthread.h>
+#include <sys/stat.h>
+
+#import "PreferenceConstants.h"
+
+// SpringBoardServices
+extern NSString * SBSCopyLocalizedApplicationNameForDisplayIdentifier(NSString *identifier);
+extern NSArray * SBSCopyApplicationDisplayIdentifiers(BOOL activeOnly, BOOL unknown);
+
+// Paths that are modified whenever applications are installed or removed
+// NOTE: The first is updated by MobileInstallation (App Store apps), the
+//       second by package installs of system-style apps.
+static const char * const stampPaths[] = {
+    "/var/mobile/Library/Caches/com.apple.mobile.installation.plist",
+    "/Applications"
+};
+#define kNumStampPaths (sizeof(stampPaths) / sizeof(stampPaths[0]))
+
+static pthread_mutex_t lock_ = PTHREAD_MUTEX_INITIALIZER;
+static time_t stamps_[kNumStampPaths];
+static NSUInteger generation_ = 0;
+static BOOL needsValidation_ = YES;
+
+// Snapshot contents; created on demand
+static NSArray *identifiers_ = nil;
+static NSSet *installed_ = nil;
+static NSMutableDictionary *checked_ = nil;
+static NSDictionary *defaults_ = nil;
+
+//==============================================================================
+
+// NOTE: The following functions must be called with lock_ held.
+
+static void validateSnapshot()
+{
+    if (!needsValidation_)
+        return;
+    needsValidation_ = NO;
+
+    BOOL changed = (generation_ == 0);
+    for (unsigned int i = 0; i < kNumStampPaths; i++) {
+        struct stat st;
+        time_t mtime = (stat(stampPaths[i], &st) == 0) ? st.st_mtime : 0;
+        if (mtime != stamps_[i]) {
+            stamps_[i] = mtime;
+            changed = YES;
+        }
+    }
+
+    if (changed) {
+        // Discard the previous snapshot
+        generation_++;
+        [identifiers_ release];
+        identifiers_ = nil;
+        [installed_ release];
+        installed_ = nil;
+        [checked_ release];
+        checked_ = nil;
+        [defaults_ release];
+        defaults_ = nil;
+    }
+}
+
+static NSSet *installedSet()
+{
+    validateSnapshot();
+
+    if (installed_ == nil) {
+        NSMutableArray *identifiers = [NSMutableArray array];
+
+        // Get list of non-hidden applications
+        NSArray *nonhidden = SBSCopyApplicationDisplayIdentifiers(NO, NO);
+        if (nonhidden != nil) {
+            [identifiers addObjectsFromArray:nonhidden];
+            [nonhidden release];
+        }
+
+        // Get list of hidden applications (assuming LibHide is installed)
+        NSString *filePath = [NSHomeDirectory() stringByAppendingPathComponent:@"Library/LibHide/hidden.plist"];
+        id value = [[NSDictionary dictionaryWithContentsOfFile:filePath] objectForKey:@"Hidden"];
+        if ([value isKindOfClass:[NSArray class]])
+            [identifiers addObjectsFromArray:value];
+
+        identifiers_ = [identifiers copy];
+        installed_ = [[NSSet alloc] initWithArray:identifiers];
+        checked_ = [[NSMutableDictionary alloc] init];
+    }
+
+    return installed_;
+}
+
+static BOOL isInstalled(NSString *displayId)
+{
+    if ([installedSet() containsObject:displayId])
+        return YES;
+
+    // NOTE: Not all apps are included in the list (e.g. apps hidden by
+    //       SpringBoard itself); for these, check for a display name.
+    NSNumber *result = [checked_ objectForKey:displayId];
+    if (result == nil) {
+        NSString *displayName = SBSCopyLocalizedApplicationNameForDisplayIdentifier(displayId);
+        result = [NSNumber numberWithBool:(displayName != nil)];
+        [displayName release];
+        [checked_ setObject:result forKey:displayId];
+    }
+    return [result boolValue];
+}
+
+static NSDictionary *filter(NSDictionary *apps)
+{
+    NSMutableDictionary *dict = [NSMutableDictionary dictionaryWithDictionary:apps];
+    for (NSString *displayId in apps)
+        if (!isInstalled(displayId))
+            [dict removeObjectForKey:displayId];
+    return dict;
+}
+
+//==============================================================================
+
+NSUInteger installedApplicationsGeneration(void)
+{
+    pthread_mutex_lock(&lock_);
+    validateSnapshot();
+    NSUInteger generation = generation_;
+    pthread_mutex_unlock(&lock_);
+    return generation;
+}
+
+void invalidateInstalledApplications(void)
+{
+    pthread_mutex_lock(&lock_);
+    needsValidation_ = YES;
+    pthread_mutex_unlock(&lock_);
+}
+
+NSArray *installedApplicationIdentifiers(void)
+{
+    pthread_mutex_lock(&lock_);
+    installedSet();
+    NSArray *identifiers = [identifiers_ retain];
+    pthread_mutex_unlock(&lock_);
+    return [identifiers autorelease];
+}
+
+BOOL isApplicationInstalled(NSString *displayId)
+{
+    pthread_mutex_lock(&lock_);
+    BOOL ret = isInstalled(displayId);
+    pthread_mutex_unlock(&lock_);
+    return ret;
+}
+
+NSDictionary *filterNotInstalled(NSDictionary *apps)
+{
+    pthread_mutex_lock(&lock_);
+    NSDictionary *dict = [filter(apps) retain];
+    pthread_mutex_unlock(&lock_);
+    return [dict autorelease];
+}
+
+NSDictionary *defaultPreferences(void)
+{
+    pthread_mutex_lock(&lock_);
+    validateSnapshot();
+    if (defaults_ == nil) {
+        // Read list of default values from disk
+        NSMutableDictionary *dict = [NSMutableDictionary dictionaryWithContentsOfFile:
+            [[NSBundle mainBundle] pathForResource:@"Defaults" ofType:@"plist"]];
+
+        // Filter out overrides for apps that do not exist on this device
+        [dict setObject:filter([dict objectForKey:kOverrides]) forKey:kOverrides];
+
+        defaults_ = [dict copy];
+    }
+    NSDictionary *dict = [defaults_ retain];
+    pthread_mutex_unlock(&lock_);
+    return [dict autorelease];
+}
+
+/* vim: set filetype=objc sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */
@@ -43,27 +43,10 @@
 #import "OverridesController.h"
 
 #import "ApplicationCell.h"
+#import "DisplayNames.h"
 #import "Preferences.h"
 #import "PreferencesController.h"
 
-// SpringBoardServices
-extern NSString * SBSCopyLocalizedApplicationNameForDisplayIdentifier(NSString *identifier);
-
-//==============================================================================
-
-static NSInteger compareDisplayNames(NSString *a, NSString *b, void *context)
-{
-    NSInteger ret;
-
-    NSString *name_a = SBSCopyLocalizedApplicationNameForDisplayIdentifier(a);
-    NSString *name_b = SBSCopyLocalizedApplicationNameForDisplayIdentifier(b);
-    ret = [name_a caseInsensitiveCompare:name_b];
-    [name_a release];
-    [name_b release];
-
-    return ret;
-}
-
 //==============================================================================
 
 @interface OverridesController (Private)
@@ -107,13 +90,19 @@ static NSInteger compareDisplayNames(NSString *a, NSString *b, void *context)
 {
     // Update the table contents
     [applications release];
-    applications = [[[Preferences sharedInstance] objectForKey:kOverrides] allKeys];
-    applications = [[applications sortedArrayUsingFunction:compareDisplayNames context:NULL] retain];
+    applications = [sortedByDisplayName([[[Preferences sharedInstance] objectForKey:kOverrides] allKeys]) retain];
 
     // Refresh the table
     [self.tableView reloadData];
 }
 
+- (void)viewWillDisappear:(BOOL)animated
+{
+    // Write out any changes made in this view
+    [[Preferences sharedInstance] flushChanges];
+    [super viewWillDisappear:animated];
+}
+
 - (UIView *)tableHeaderView
 {
     // Determine size of application frame (iPad, iPhone differ)
@@ -3,7 +3,7 @@
  * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
  * Description: allow applications to run in the background
  * Author: Lance Fetters (aka. ashikase)
- * Last-modified: 2010-05-08 02:08:27
+ * Last-modified: 2026-10-17 22:58:23
  */
 
 /**
@@ -47,6 +47,7 @@
 {
     NSDictionary *initialValues;
     NSMutableArray *respringRequestors;
+    BOOL hasUnsavedChanges;
 }
 
 @property(nonatomic, readonly) BOOL needsRespring;
@@ -55,6 +56,10 @@
 
 - (void)resetToDefaults;
 
+// Write any pending changes to disk and notify SpringBoard
+// NOTE: Changes are otherwise written after a short delay.
+- (void)flushChanges;
+
 - (id)objectForKey:(NSString *)defaultName forDisplayIdentifier:(NSString *)displayId;
 - (BOOL)boolForKey:(NSString *)defaultName forDisplayIdentifier:(NSString *)displayId;
 - (NSInteger)integerForKey:(NSString *)defaultName forDisplayIdentifier:(NSString *)displayId;
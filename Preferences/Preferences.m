@@ -3,7 +3,7 @@
  * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
  * Description: allow applications to run in the background
  * Author: Lance Fetters (aka. ashikase)
- * Last-modified: 2010-06-12 03:49:53
+ * Last-modified: 2026-10-17 23:04:12
  */
 
 /**
@@ -44,26 +44,50 @@
 
 #import <notify.h>
 
-// SpringBoardServices
-extern NSString * SBSCopyLocalizedApplicationNameForDisplayIdentifier(NSString *identifier);
+#import "InstalledApplications.h"
+
+// Delay (in seconds) over which changes are collected before being written
+#define kWriteBehindDelay 0.5
 
 //==============================================================================
 
-// Filter out overrides for apps that do not or no longer exist on this device
-NSDictionary * filterNotInstalled(NSDictionary *apps)
+// Settings that app processes read once, at launch
+// NOTE: A running app does not see changes to these; a respring is required
+//       so that apps are relaunched with the new values.
+static NSArray *keysReadAtLaunch()
+{
+    static NSArray *keys = nil;
+    if (keys == nil)
+        keys = [[NSArray alloc] initWithObjects:kBackgroundingMethod, kFallbackToNative,
+            kFastAppSwitchingEnabled, kForceFastAppSwitching, kBackgroundTaskBudget, nil];
+    return keys;
+}
+
+static BOOL valuesDifferForKeys(NSDictionary *oldDict, NSDictionary *newDict, NSArray *keys)
 {
-    NSMutableDictionary *dict = [NSMutableDictionary dictionaryWithDictionary:apps];
-
-    for (NSString *displayId in [dict allKeys]) {
-        NSString *displayName = SBSCopyLocalizedApplicationNameForDisplayIdentifier(displayId);
-        if (displayName == nil)
-            // App has no display name; assume not installed
-            [dict removeObjectForKey:displayId];
-        else
-            [displayName release];
+    for (NSString *key in keys) {
+        id oldValue = [oldDict objectForKey:key];
+        id newValue = [newDict objectForKey:key];
+        if (oldValue != newValue && ![oldValue isEqual:newValue])
+            return YES;
     }
+    return NO;
+}
 
-    return dict;
+// NOTE: Only compares the settings read by app processes at launch.
+static BOOL launchSettingsDiffer(NSString *defaultName, id oldValue, id newValue)
+{
+    NSArray *keys = keysReadAtLaunch();
+    if ([defaultName isEqualToString:kGlobal])
+        return valuesDifferForKeys(oldValue, newValue, keys);
+
+    // Overrides; compare the settings of each app
+    NSMutableSet *displayIds = [NSMutableSet setWithArray:[oldValue allKeys]];
+    [displayIds addObjectsFromArray:[newValue allKeys]];
+    for (NSString *displayId in displayIds)
+        if (valuesDifferForKeys([oldValue objectForKey:displayId], [newValue objectForKey:displayId], keys))
+            return YES;
+    return NO;
 }
 
 //==============================================================================
@@ -99,14 +123,17 @@ NSDictionary * filterNotInstalled(NSDictionary *apps)
         respringRequestors = [[NSMutableArray alloc] init];
 
         // Filter out overrides for apps that are no longer installed
-        NSDictionary *dict = filterNotInstalled([initialValues objectForKey:kOverrides]);
-        [self setObject:dict forKey:kOverrides];
+        NSDictionary *overrides = [initialValues objectForKey:kOverrides];
+        NSDictionary *dict = filterNotInstalled(overrides);
+        if ([dict count] != [overrides count])
+            [self setObject:dict forKey:kOverrides];
     }
     return self;
 }
 
 - (void)dealloc
 {
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(flushChanges) object:nil];
     [respringRequestors release];
     [initialValues release];
     [super dealloc];
@@ -114,19 +141,10 @@ NSDictionary * filterNotInstalled(NSDictionary *apps)
 
 - (NSDictionary *)defaults
 {
-    // Read list of default values from disk
-    NSMutableDictionary *dict = [NSMutableDictionary dictionaryWithContentsOfFile:
-        [[NSBundle mainBundle] pathForResource:@"Defaults" ofType:@"plist"]];
-
-    // Filter out overrides for apps that do not exist on this device
-    // NOTE: Cannot rely on filter in init, as this this method is also called
-    //       by resetToDefaults.
-    NSDictionary *overDict = filterNotInstalled([dict objectForKey:kOverrides]);
-
-    // Update overrides
-    [dict setObject:overDict forKey:kOverrides];
-
-    return dict;
+    // NOTE: The parsed list of default values (with overrides for apps that
+    //       do not exist on this device filtered out) is shared and only
+    //       rebuilt when the set of installed apps changes.
+    return defaultPreferences();
 }
 
 - (void)resetToDefaults
@@ -135,10 +153,15 @@ NSDictionary * filterNotInstalled(NSDictionary *apps)
     NSDictionary *dict = [self defaults];
     [self setObject:[dict objectForKey:kGlobal] forKey:kGlobal];
     [self setObject:[dict objectForKey:kOverrides] forKey:kOverrides];
+    [self setObject:[dict objectForKey:kMaxBackgroundedApps] forKey:kMaxBackgroundedApps];
 }
 
 - (NSArray *)keysRequiringRespring
 {
+    // NOTE: Other changes to global settings and overrides are applied by
+    //       SpringBoard upon receiving the preferenceChanged notification;
+    //       only the settings read by app processes at launch (see
+    //       keysReadAtLaunch()) require a respring.
     return [NSArray arrayWithObjects:kGlobal, kOverrides, nil];
 }
 
@@ -147,14 +170,17 @@ NSDictionary * filterNotInstalled(NSDictionary *apps)
     // Update the value
     [super setObject:value forKey:defaultName];
 
-    // Immediately write to disk
-    [self synchronize];
+    // Write to disk after a short delay, along with any further changes
+    if (!hasUnsavedChanges) {
+        hasUnsavedChanges = YES;
+        [self performSelector:@selector(flushChanges) withObject:nil afterDelay:kWriteBehindDelay];
+    }
 
     // Check if the selected key requires a respring
     if ([[self keysRequiringRespring] containsObject:defaultName]) {
-        // Make sure that the value differe from the initial value
+        // Make sure that the value differs from the initial value
         id initialValue = [initialValues objectForKey:defaultName];
-        BOOL valuesDiffer = ![value isEqual:initialValue];
+        BOOL valuesDiffer = launchSettingsDiffer(defaultName, initialValue, value);
         // FIXME: Write to disk, remove on respring
         // FIXME: Show drop down to indicate respring is needed
         if (valuesDiffer) {
@@ -164,8 +190,20 @@ NSDictionary * filterNotInstalled(NSDictionary *apps)
             [respringRequestors removeObject:defaultName];
         }
     }
+}
 
-    // Send notification that a preference has changed
+- (void)flushChanges
+{
+    if (!hasUnsavedChanges)
+        return;
+
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(flushChanges) object:nil];
+    hasUnsavedChanges = NO;
+
+    // Write all changes to disk at once
+    [self synchronize];
+
+    // Send notification that preferences have changed
     notify_post(APP_ID".preferenceChanged");
 }
 
@@ -178,20 +216,15 @@ NSDictionary * filterNotInstalled(NSDictionary *apps)
 
 - (id)objectForKey:(NSString *)defaultName forDisplayIdentifier:(NSString *)displayId
 {
-    NSDictionary *dict = nil;
-    if (displayId != nil) {
-        // Retrieve settings for the specified application
-        dict = [[self objectForKey:kOverrides] objectForKey:displayId];
-        if (dict == nil)
-            // Settings do not exist; use global settings
-            dict = [self objectForKey:kGlobal];
-    } else {
-        // Retrieve global settings
-        dict = [self objectForKey:kGlobal];
-    }
+    id value = nil;
+    if (displayId != nil)
+        // Retrieve setting for the specified application (if overridden)
+        value = [[[self objectForKey:kOverrides] objectForKey:displayId] objectForKey:defaultName];
+
+    if (value == nil)
+        // Setting is not overridden; use global settings
+        value = [[self objectForKey:kGlobal] objectForKey:defaultName];
 
-    // Retrieve the value for the specified key
-    id value = [dict objectForKey:defaultName];
     if (value == nil)
         // Key may not have existed in previous version; check default global values
         value = [[[self defaults] objectForKey:kGlobal] objectForKey:defaultName];
@@ -226,13 +259,10 @@ NSDictionary * filterNotInstalled(NSDictionary *apps)
     NSMutableDictionary *dict = nil;
     if (displayId != nil) {
         // Retrieve settings for the specified application
-        dict = [[self objectForKey:kOverrides] objectForKey:displayId];
-        if (dict == nil)
-            // Settings do not exist; copy global settings
-            dict = [self objectForKey:kGlobal];
-
-        // Create mutable copy
-        dict = [NSMutableDictionary dictionaryWithDictionary:dict];
+        // NOTE: Overrides only store the settings that have been changed for
+        //       the app; other settings are taken from the global settings.
+        dict = [NSMutableDictionary dictionaryWithDictionary:
+            [[self objectForKey:kOverrides] objectForKey:displayId]];
 
         // Store the value
         [dict setObject:value forKey:defaultName];
@@ -272,8 +302,9 @@ NSDictionary * filterNotInstalled(NSDictionary *apps)
 
 - (void)addOverrideForDisplayId:(NSString *)displayId
 {
+    // NOTE: App starts with all settings taken from the global settings
     NSMutableDictionary *dict = [NSMutableDictionary dictionaryWithDictionary:[self objectForKey:kOverrides]];
-    [dict setObject:[self objectForKey:kGlobal] forKey:displayId];
+    [dict setObject:[NSDictionary dictionary] forKey:displayId];
     [self setObject:dict forKey:kOverrides];
 }
 
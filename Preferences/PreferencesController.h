@@ -3,7 +3,7 @@
  * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
  * Description: allow applications to run in the background
  * Author: Lance Fetters (aka. ashikase)
- * Last-modified: 2010-08-11 18:29:54
+ * Last-modified: 2026-10-17 23:02:58
  */
 
 /**
@@ -42,8 +42,9 @@
 
 #import "HtmlDocController.h"
 #import "PreferenceConstants.h"
+#import "ValueListController.h"
 
-@interface PreferencesController : UITableViewController <HtmlDocControllerDelegate>
+@interface PreferencesController : UITableViewController <HtmlDocControllerDelegate, ValueListControllerDelegate>
 {
     NSString *displayIdentifier;
 
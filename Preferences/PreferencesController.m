@@ -3,7 +3,7 @@
  * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
  * Description: allow applications to run in the background
  * Author: Lance Fetters (aka. ashikase)
- * Last-modified: 2012-01-16 18:20:20
+ * Last-modified: 2026-10-17 23:04:12
  */
 
 /**
@@ -45,17 +45,105 @@
 #import <QuartzCore/QuartzCore.h>
 
 #import "Constants.h"
+#import "DisplayNames.h"
 #import "HtmlDocController.h"
 #import "Preferences.h"
 #import "ToggleButton.h"
 
-extern NSString * SBSCopyLocalizedApplicationNameForDisplayIdentifier(NSString *identifier);
-
 static BOOL isFirmware3x_ = NO;
 
+// Number of items in each section, when all items are shown
+// NOTE: Items of the first section are the backgrounding methods.
+static const int sectionItemCounts[] = {5, 3, 4, 2, 2, 4};
+
+// Preference set by each item
+static NSString *itemKeys[][4] = {
+    {nil},
+    {kFastAppSwitchingEnabled, kForceFastAppSwitching, kBackgroundTaskBudget},
+    {kFallbackToNative, kThrottleRunDuration, kThrottlePeriod, kIdleTimeout},
+    {kEnableAtLaunch, kPersistent},
+    {kBadgeEnabled, kStatusBarIconEnabled},
+    {kMinimizeOnToggle, kSuspendImmediately, kFeedbackDuration, kMaxBackgroundedApps}
+};
+
+//==============================================================================
+
+static NSArray *arrayOfNumbers(const double *numbers, size_t count)
+{
+    NSMutableArray *array = [NSMutableArray arrayWithCapacity:count];
+    for (size_t i = 0; i < count; ++i)
+        [array addObject:[NSNumber numberWithDouble:numbers[i]]];
+    return array;
+}
+
+// Values from which settings that are not simply on or off are chosen
+// NOTE: Returns nil for on/off settings.
+static NSArray *valuesForKey(NSString *key)
+{
+    // NOTE: Each run duration is shorter than the shortest period.
+    static const double throttleRunDurations[] = {0.5, 1.0, 2.0, 5.0};
+    static const double throttlePeriods[] = {10.0, 30.0, 60.0};
+    // NOTE: Idle timeouts are in minutes.
+    static const double idleTimeouts[] = {0, 5.0, 15.0, 30.0, 60.0, 120.0, 240.0};
+    static const double backgroundTaskBudgets[] = {0, 10.0, 30.0, 60.0, 180.0, 600.0};
+    static const double feedbackDurations[] = {0.3, 0.5, 0.7, 1.0, 1.5};
+    static const double appCounts[] = {0, 1, 2, 3, 4, 5, 8, 10};
+
+    if ([key isEqualToString:kThrottleRunDuration])
+        return arrayOfNumbers(throttleRunDurations, sizeof(throttleRunDurations) / sizeof(double));
+    else if ([key isEqualToString:kThrottlePeriod])
+        return arrayOfNumbers(throttlePeriods, sizeof(throttlePeriods) / sizeof(double));
+    else if ([key isEqualToString:kIdleTimeout])
+        return arrayOfNumbers(idleTimeouts, sizeof(idleTimeouts) / sizeof(double));
+    else if ([key isEqualToString:kBackgroundTaskBudget])
+        return arrayOfNumbers(backgroundTaskBudgets, sizeof(backgroundTaskBudgets) / sizeof(double));
+    else if ([key isEqualToString:kFeedbackDuration])
+        return arrayOfNumbers(feedbackDurations, sizeof(feedbackDurations) / sizeof(double));
+    else if ([key isEqualToString:kMaxBackgroundedApps])
+        return arrayOfNumbers(appCounts, sizeof(appCounts) / sizeof(double));
+    else
+        return nil;
+}
+
+// NOTE: Duration is in seconds.
+static NSString *titleForDuration(double duration)
+{
+    NSString *unit = @"second";
+    if (duration >= 3600.0) {
+        duration /= 3600.0;
+        unit = @"hour";
+    } else if (duration >= 60.0) {
+        duration /= 60.0;
+        unit = @"minute";
+    }
+    return [NSString stringWithFormat:((duration == 1.0) ? @"%g %@" : @"%g %@s"), duration, unit];
+}
+
+static NSString *titleForValue(NSString *key, id value)
+{
+    double number = [value isKindOfClass:[NSNumber class]] ? [value doubleValue] : 0;
+    if ([key isEqualToString:kIdleTimeout])
+        return (number == 0) ? @"Never" : titleForDuration(number * 60.0);
+    else if ([key isEqualToString:kBackgroundTaskBudget])
+        return (number == 0) ? @"No Limit" : titleForDuration(number);
+    else if ([key isEqualToString:kMaxBackgroundedApps])
+        return (number == 0) ? @"No Limit" :
+            [NSString stringWithFormat:((number == 1.0) ? @"%g app" : @"%g apps"), number];
+    else
+        return titleForDuration(number);
+}
+
+//==============================================================================
+
 @interface PreferencesController (Private)
 - (void)updateSectionVisibility;
 - (UIView *)tableHeaderView;
+- (int)sectionForTableSection:(int)section;
+- (BOOL)isItemShown:(int)item inSection:(int)section;
+- (int)itemForRow:(int)row inSection:(int)section;
+- (NSString *)keyForRowAtIndexPath:(NSIndexPath *)indexPath;
+- (id)objectForItemKey:(NSString *)key;
+- (void)setObject:(id)value forItemKey:(NSString *)key;
 @end
 
 @implementation PreferencesController
@@ -73,7 +161,7 @@ static BOOL isFirmware3x_ = NO;
         displayIdentifier = [displayId copy];
 
         self.title = (displayId == nil) ? @"Global Settings" :
-            [SBSCopyLocalizedApplicationNameForDisplayIdentifier(displayId) autorelease];
+            displayNameForIdentifier(displayId);
 
         self.navigationItem.backBarButtonItem = [[UIBarButtonItem alloc] initWithTitle:@"Back"
             style:UIBarButtonItemStyleBordered target:nil action:nil];
@@ -101,12 +189,30 @@ static BOOL isFirmware3x_ = NO;
     [super dealloc];
 }
 
+- (void)viewWillAppear:(BOOL)animated
+{
+    [super viewWillAppear:animated];
+
+    // Reset the table by deselecting the current selection
+    [self.tableView deselectRowAtIndexPath:[self.tableView indexPathForSelectedRow] animated:YES];
+}
+
+- (void)viewWillDisappear:(BOOL)animated
+{
+    // Write out any changes made in this view
+    [[Preferences sharedInstance] flushChanges];
+    [super viewWillDisappear:animated];
+}
+
 #pragma mark - Miscellaneous
 
 - (void)updateSectionVisibility
 {
     // Update section visibility flags
-    showBackgrounderOptions = (backgroundingMethod == BGBackgroundingMethodBackgrounder);
+    // NOTE: "Throttled" method is a variant of "Backgrounder", and so shares
+    //       its options.
+    showBackgrounderOptions = (backgroundingMethod == BGBackgroundingMethodBackgrounder
+        || backgroundingMethod == BGBackgroundingMethodThrottled);
     showNativeOptions = !isFirmware3x_
         && ((backgroundingMethod == BGBackgroundingMethodNative)
         || (showBackgrounderOptions && [[Preferences sharedInstance]
@@ -116,6 +222,74 @@ static BOOL isFirmware3x_ = NO;
     sectionOffset = !showNativeOptions + !showBackgrounderOptions;
 }
 
+// NOTE: Returns the section as numbered when all sections are shown.
+- (int)sectionForTableSection:(int)section
+{
+    // Adjust section based on visibility of Native/Backgrounder options
+    if (section > 1 || (section == 1 && !showNativeOptions))
+        section += sectionOffset;
+    return section;
+}
+
+- (BOOL)isItemShown:(int)item inSection:(int)section
+{
+    switch (section) {
+        case 0:
+            // Auto Detect method is not available on firmware 3.x
+            return !(isFirmware3x_ && item == BGBackgroundingMethodAutoDetect);
+        case 1:
+            // "Even if Unsupported" only applies with Fast App Switching
+            return (item != 1 || showEvenIfUnsupported);
+        case 2:
+            if (item == 3)
+                // Idle timeout only applies to the "Forced" method
+                return (backgroundingMethod == BGBackgroundingMethodBackgrounder);
+            else
+                // Duty cycle only applies to the "Throttled" method
+                return (item == 0 || backgroundingMethod == BGBackgroundingMethodThrottled);
+        case 5:
+            // Limit on backgrounded apps applies to all apps
+            return (item != 3 || displayIdentifier == nil);
+        default:
+            return YES;
+    }
+}
+
+- (int)itemForRow:(int)row inSection:(int)section
+{
+    int item = 0;
+    for (; item < sectionItemCounts[section]; ++item)
+        if ([self isItemShown:item inSection:section] && row-- == 0)
+            break;
+    return item;
+}
+
+- (NSString *)keyForRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    int section = [self sectionForTableSection:indexPath.section];
+    return itemKeys[section][[self itemForRow:indexPath.row inSection:section]];
+}
+
+// NOTE: Settings that apply to all apps are stored outside of the global
+//       settings, and so cannot be overridden.
+- (id)objectForItemKey:(NSString *)key
+{
+    Preferences *prefs = [Preferences sharedInstance];
+    if ([key isEqualToString:kMaxBackgroundedApps])
+        return [prefs objectForKey:key];
+    else
+        return [prefs objectForKey:key forDisplayIdentifier:displayIdentifier];
+}
+
+- (void)setObject:(id)value forItemKey:(NSString *)key
+{
+    Preferences *prefs = [Preferences sharedInstance];
+    if ([key isEqualToString:kMaxBackgroundedApps])
+        [prefs setObject:value forKey:key];
+    else
+        [prefs setObject:value forKey:key forDisplayIdentifier:displayIdentifier];
+}
+
 - (UIView *)tableHeaderView
 {
     // Determine size of application frame (iPad, iPhone differ)
@@ -161,23 +335,12 @@ static BOOL isFirmware3x_ = NO;
 
 - (int)tableView:(UITableView *)tableView numberOfRowsInSection:(int)section
 {
-    static int rows[] = {4, 2, 1, 2, 2, 1};
-
-    // Adjust section based on visibility of Native/Backgrounder options
-    if (section > 1 || (section == 1 && !showNativeOptions))
-        section += sectionOffset;
+    section = [self sectionForTableSection:section];
 
     // Get number of rows for requested section
-    int ret = rows[section];
-    if (section == 0) {
-        if (isFirmware3x_)
-            // Don't show Auto Detect method
-            ret--;
-    } else if (section == 1 && showNativeOptions) {
-        // Adjust number of rows in Native options section
-        ret -= !showEvenIfUnsupported;
-    }
-
+    int ret = 0;
+    for (int item = 0; item < sectionItemCounts[section]; ++item)
+        ret += [self isItemShown:item inSection:section];
     return ret;
 }
 
@@ -185,32 +348,38 @@ static BOOL isFirmware3x_ = NO;
 {
     static NSString *reuseIdToggle = @"ToggleCell";
     static NSString *reuseIdSimple = @"SimpleCell";
-
-    static NSString *cellTitles[][4] = {
-        {@"Off", @"Native", @"Forced", @"Auto Detect"},
-        {@"Fast App Switching", @"\u21b3 Even if Unsupported", nil, nil},
-        {@"Fall Back to Native", nil, nil, nil},
-        {@"Enable at Launch", @"Stay Enabled", nil, nil},
-        {@"Badge", @"Status Bar Icon", nil, nil},
-        {@"Minimize on Toggle", nil, nil, nil}
+    static NSString *reuseIdValue = @"ValueCell";
+
+    static NSString *cellTitles[][5] = {
+        {@"Off", @"Native", @"Forced", @"Auto Detect", @"Throttled"},
+        {@"Fast App Switching", @"\u21b3 Even if Unsupported", @"Task Time Limit"},
+        {@"Fall Back to Native", @"Run For", @"Out of Every", @"Disable After Idle"},
+        {@"Enable at Launch", @"Stay Enabled"},
+        {@"Badge", @"Status Bar Icon"},
+        {@"Minimize on Toggle", @"Suspend Immediately", @"Show Feedback For", @"Keep at Most"}
     };
-    static NSString *cellSubtitles[][4] = {
+    static NSString *cellSubtitles[][5] = {
         {@"App will quit when minimized", @"Use iOS multitasking, if supported",
-            @"Uses more CPU and RAM", @"Native if supported, else Forced"},
-        {@"Keep apps paused in memory", @"Include apps not updated for iOS4", nil, nil},
-        {@"If state disabled, use native method", nil, nil, nil},
-        {@"No need to manually enable", @"Must be disabled manually", nil, nil},
-        {@"Mark the app's icon", @"Mark the app's status bar", nil, nil},
-        {@"Minimize app when toggling state", nil, nil, nil}
+            @"Uses more CPU and RAM", @"Native if supported, else Forced",
+            @"Forced, but paused most of the time"},
+        {@"Keep apps paused in memory", @"Include apps not updated for iOS4"},
+        {@"If state disabled, use native method"},
+        {@"No need to manually enable", @"Must be disabled manually"},
+        {@"Mark the app's icon", @"Mark the app's status bar"},
+        {@"Minimize app when toggling state", @"Don't wait for feedback to finish"}
     };
     static NSString *methodImages[] = {
-        @"method_off.png", @"method_native.png", @"method_backgrounder.png", @"method_autodetect.png"
+        @"method_off.png", @"method_native.png", @"method_backgrounder.png", @"method_autodetect.png",
+        @"method_backgrounder.png"
     };
 
-    int offset = 0;
+    int section = [self sectionForTableSection:indexPath.section];
+    int item = [self itemForRow:indexPath.row inSection:section];
+    NSString *key = itemKeys[section][item];
+    Preferences *prefs = [Preferences sharedInstance];
 
     UITableViewCell *cell = nil;
-    if (indexPath.section == 0) {
+    if (section == 0) {
         // Backgrounding method
  
         // Try to retrieve from the table view a now-unused cell with the given identifier
@@ -221,18 +390,26 @@ static BOOL isFirmware3x_ = NO;
             cell.selectionStyle = UITableViewCellSelectionStyleGray;
         }
 
-        cell.accessoryType = (backgroundingMethod == indexPath.row) ? UITableViewCellAccessoryCheckmark : UITableViewCellAccessoryNone;
+        cell.accessoryType = (backgroundingMethod == item) ? UITableViewCellAccessoryCheckmark : UITableViewCellAccessoryNone;
+        cell.detailTextLabel.text = cellSubtitles[section][item];
 
         // Set image for cell
-        cell.imageView.image = [UIImage imageNamed:methodImages[indexPath.row]];
+        cell.imageView.image = [UIImage imageNamed:methodImages[item]];
+    } else if (valuesForKey(key) != nil) {
+        // Settings chosen from a list of values
+
+        // Try to retrieve from the table view a now-unused cell with the given identifier
+        cell = [tableView dequeueReusableCellWithIdentifier:reuseIdValue];
+        if (cell == nil) {
+            // Cell does not exist, create a new one
+            cell = [[[UITableViewCell alloc] initWithStyle:UITableViewCellStyleValue1 reuseIdentifier:reuseIdValue] autorelease];
+            cell.selectionStyle = UITableViewCellSelectionStyleGray;
+            cell.accessoryType = UITableViewCellAccessoryDisclosureIndicator;
+        }
+
+        cell.detailTextLabel.text = titleForValue(key, [self objectForItemKey:key]);
     } else {
         // Backgrounding indicators, Other
-        static NSString *keys[][2] = {
-            {kFastAppSwitchingEnabled, kForceFastAppSwitching},
-            {kFallbackToNative, nil},
-            {kEnableAtLaunch, kPersistent},
-            {kBadgeEnabled, kStatusBarIconEnabled},
-            {kMinimizeOnToggle, nil}};
 
         // Try to retrieve from the table view a now-unused cell with the given identifier
         cell = [tableView dequeueReusableCellWithIdentifier:reuseIdToggle];
@@ -246,21 +423,17 @@ static BOOL isFirmware3x_ = NO;
             cell.accessoryView = button;
         }
 
-        // Determine the section offset
-        offset = (indexPath.section == 1 && showNativeOptions) ? 0 : sectionOffset;
-
         UIButton *button = (UIButton *)cell.accessoryView;
-        Preferences *prefs = [Preferences sharedInstance];
-        button.selected = [prefs boolForKey:keys[(indexPath.section - 1) + offset][indexPath.row] forDisplayIdentifier:displayIdentifier];
+        button.selected = [prefs boolForKey:key forDisplayIdentifier:displayIdentifier];
+        cell.detailTextLabel.text = cellSubtitles[section][item];
 
         // Set image for cell
-        cell.imageView.image = (indexPath.section == 4) ?
-            [UIImage imageNamed:((indexPath.row == 0) ? @"badge.png" : @"status_bar_icon.png")] :
+        cell.imageView.image = (section == 4) ?
+            [UIImage imageNamed:((item == 0) ? @"badge.png" : @"status_bar_icon.png")] :
             nil;
     }
 
-    cell.textLabel.text = cellTitles[indexPath.section + offset][indexPath.row];
-    cell.detailTextLabel.text = cellSubtitles[indexPath.section + offset][indexPath.row];
+    cell.textLabel.text = cellTitles[section][item];
 
     return cell;
 }
@@ -284,8 +457,7 @@ static BOOL isFirmware3x_ = NO;
     };
 
     // Adjust section based on visibility of Native/Backgrounder options
-    if (section > 1 || (section == 1 && !showNativeOptions))
-        section += sectionOffset;
+    section = [self sectionForTableSection:section];
 
     // Determine size of application frame (iPad, iPhone differ)
     CGRect appFrame = [[UIScreen mainScreen] applicationFrame];
@@ -325,14 +497,15 @@ static BOOL isFirmware3x_ = NO;
 - (void)tableView:(UITableView *)tableView didSelectRowAtIndexPath:(NSIndexPath *)indexPath
 {
     if (indexPath.section == 0) {
-        if (indexPath.row  != (int)backgroundingMethod) {
+        BGBackgroundingMethod method = (BGBackgroundingMethod)[self itemForRow:indexPath.row inSection:0];
+        if (method != backgroundingMethod) {
             // Method has changed; cache previous values
             BGBackgroundingMethod prevMethod = backgroundingMethod;
             BOOL nativeOptionsWasShown = showNativeOptions;
             BOOL backgrounderOptionsWasShown = showBackgrounderOptions;
 
             // Update cached backgrounding method value
-            backgroundingMethod = (BGBackgroundingMethod)indexPath.row;
+            backgroundingMethod = method;
 
             // Update visibility flags and offset
             [self updateSectionVisibility];
@@ -352,6 +525,7 @@ static BOOL isFirmware3x_ = NO;
             // Determine which table sections to show/hide
             NSMutableIndexSet *indexesToInsert = [NSMutableIndexSet indexSet];
             NSMutableIndexSet *indexesToDelete = [NSMutableIndexSet indexSet];
+            NSMutableIndexSet *indexesToReload = [NSMutableIndexSet indexSetWithIndex:0];
             if (prevMethod == BGBackgroundingMethodOff) {
                 // Backgrounding method was Off, readd sections
                 [indexesToInsert addIndexesInRange:NSMakeRange(1, showNativeOptions + showBackgrounderOptions + 3)];
@@ -379,6 +553,15 @@ static BOOL isFirmware3x_ = NO;
 
                         break;
                     case BGBackgroundingMethodBackgrounder:
+                    case BGBackgroundingMethodThrottled:
+                        if (backgrounderOptionsWasShown) {
+                            // Switched between "Forced" and "Throttled"; only
+                            // the rows for the duty cycle and idle timeout are
+                            // added or removed
+                            [indexesToReload addIndex:(showNativeOptions ? 2 : 1)];
+                            break;
+                        }
+
                         if (showNativeOptions) {
                             // Show Backgrounder options
                             [indexesToInsert addIndex:2];
@@ -413,12 +596,28 @@ static BOOL isFirmware3x_ = NO;
             [tableView endUpdates];
 
             // Must reload first section to update selected method checkmark
-            NSIndexSet *indexesToReload = [NSIndexSet indexSetWithIndex:0];
             [tableView reloadSections:indexesToReload withRowAnimation:UITableViewRowAnimationNone];
         }
 
         // Deselect the selected row
         [tableView deselectRowAtIndexPath:indexPath animated:YES];
+    } else {
+        NSString *key = [self keyForRowAtIndexPath:indexPath];
+        NSArray *values = valuesForKey(key);
+        if (values != nil) {
+            // Show list from which to choose the value
+            NSMutableArray *titles = [NSMutableArray arrayWithCapacity:[values count]];
+            for (id value in values)
+                [titles addObject:titleForValue(key, value)];
+
+            UITableViewCell *cell = [tableView cellForRowAtIndexPath:indexPath];
+            id value = [self objectForItemKey:key];
+            ValueListController *controller = [[ValueListController alloc] initWithTitle:cell.textLabel.text
+                key:key values:values titles:titles selectedValue:value];
+            controller.delegate = self;
+            [[self navigationController] pushViewController:controller animated:YES];
+            [controller release];
+        }
     }
 }
 
@@ -426,20 +625,12 @@ static BOOL isFirmware3x_ = NO;
 
 - (void)buttonToggled:(UIButton *)button
 {
-    static NSString *keys[][2] = {
-        {kFastAppSwitchingEnabled, kForceFastAppSwitching},
-        {kFallbackToNative, nil},
-        {kEnableAtLaunch, kPersistent},
-        {kBadgeEnabled, kStatusBarIconEnabled},
-        {kMinimizeOnToggle, nil}};
-
     // Update selected state of button
     button.selected = !button.selected;
 
     // Update preference
     NSIndexPath *indexPath = [self.tableView indexPathForCell:(UITableViewCell *)[button superview]];
-    int offset = (indexPath.section == 1 && showNativeOptions) ? 0 : sectionOffset;
-    NSString *key = keys[(indexPath.section - 1) + offset][indexPath.row];
+    NSString *key = [self keyForRowAtIndexPath:indexPath];
     [[Preferences sharedInstance] setBool:button.selected forKey:key forDisplayIdentifier:displayIdentifier];
 
     if (!isFirmware3x_) {
@@ -481,27 +672,37 @@ static BOOL isFirmware3x_ = NO;
     }
 }
 
+#pragma mark - ValueListController delegate
+
+- (void)valueListController:(ValueListController *)controller didSelectValue:(id)value
+{
+    [self setObject:value forItemKey:controller.key];
+
+    // Show the new value
+    [self.tableView reloadData];
+}
+
 #pragma mark - Navigation bar delegates
 
 - (void)helpButtonTapped:(UIButton *)sender
 {
     static NSString *helpFiles[] = {
-        nil, @"help_options_native.mdwn", @"help_options_backgrounder.mdwn",
-        @"help_state.mdwn", @"help_indicators.mdwn", @"help_misc.mdwn"};
+        nil, @"help_options_native.html", @"help_options_backgrounder.html",
+        @"help_state.html", @"help_indicators.html", @"help_misc.html"};
 
     // Provide different documentation for "Backgrounding method", depending on firmware version.
     // FIXME: Find a cleaner way to do this.
     int index = sender.tag;
     NSString *helpFile = nil;
     if (index == 0)
-        helpFile = isFirmware3x_ ? @"help_method_3x.mdwn" : @"help_method_4x.mdwn";
+        helpFile = isFirmware3x_ ? @"help_method_3x.html" : @"help_method_4x.html";
     else
         helpFile = helpFiles[index];
 
     // Create and show help page
     // NOTE: Controller is released in delegate callback
     HtmlDocController *docCont = [[HtmlDocController alloc]
-        initWithContentsOfFile:helpFile templateFile:@"template.html" title:@"Help"];
+        initWithContentsOfFile:helpFile title:@"Help"];
     docCont.delegate = self;
 }
 
@@ -0,0 +1,126 @@
+/**
+ * Name: Backgrounder
+ * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
+ * Description: allow applications to run in the background
+ * Author: Lance Fetters (aka. ashikase)
+ * Last-modified: 2026-10-17 23:02:58
+ */
+
+/**
+ * Copyright (C) 2008-2010  Lance Fetters (aka. ashikase)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+
+#import "ValueListController.h"
+
+
+@implementation ValueListController
+
+@synthesize delegate;
+@synthesize key;
+
+- (id)initWithTitle:(NSString *)title key:(NSString *)key_ values:(NSArray *)values_
+    titles:(NSArray *)titles_ selectedValue:(id)value
+{
+    self = [super initWithStyle:UITableViewStyleGrouped];
+    if (self) {
+        self.title = title;
+
+        key = [key_ copy];
+        values = [values_ retain];
+        titles = [titles_ retain];
+        selectedIndex = (value != nil) ? [values indexOfObject:value] : NSNotFound;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [titles release];
+    [values release];
+    [key release];
+    [super dealloc];
+}
+
+#pragma mark - UITableViewDataSource
+
+- (int)numberOfSectionsInTableView:(UITableView *)tableView
+{
+    return 1;
+}
+
+- (int)tableView:(UITableView *)tableView numberOfRowsInSection:(int)section
+{
+    return [values count];
+}
+
+- (UITableViewCell *)tableView:(UITableView *)tableView cellForRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    static NSString *reuseIdSimple = @"SimpleCell";
+
+    // Try to retrieve from the table view a now-unused cell with the given identifier
+    UITableViewCell *cell = [tableView dequeueReusableCellWithIdentifier:reuseIdSimple];
+    if (cell == nil) {
+        // Cell does not exist, create a new one
+        cell = [[[UITableViewCell alloc] initWithStyle:UITableViewCellStyleDefault reuseIdentifier:reuseIdSimple] autorelease];
+        cell.selectionStyle = UITableViewCellSelectionStyleGray;
+    }
+
+    cell.textLabel.text = [titles objectAtIndex:indexPath.row];
+    cell.accessoryType = ((NSUInteger)indexPath.row == selectedIndex) ?
+        UITableViewCellAccessoryCheckmark : UITableViewCellAccessoryNone;
+
+    return cell;
+}
+
+#pragma mark - UITableViewCellDelegate
+
+- (void)tableView:(UITableView *)tableView didSelectRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    if ((NSUInteger)indexPath.row != selectedIndex) {
+        // Move the checkmark to the chosen value
+        NSMutableArray *indexPaths = [NSMutableArray arrayWithObject:indexPath];
+        if (selectedIndex != NSNotFound)
+            [indexPaths addObject:[NSIndexPath indexPathForRow:selectedIndex inSection:0]];
+        selectedIndex = indexPath.row;
+        [tableView reloadRowsAtIndexPaths:indexPaths withRowAnimation:UITableViewRowAnimationNone];
+
+        // Store the new value
+        [delegate valueListController:self didSelectValue:[values objectAtIndex:selectedIndex]];
+    }
+
+    // Deselect the selected row
+    [tableView deselectRowAtIndexPath:indexPath animated:YES];
+}
+
+@end
+
+/* vim: set filetype=objc sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */
@@ -0,0 +1,304 @@
+/**
+ * Name: Backgrounder
+ * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
+ * Description: allow applications to run in the background
+ * Author: Lance Fetters (aka. ashikase)
+ * Last-modified: 2026-10-17 22:57:55
+ */
+
+/**
+ * Copyright (C) 2008-2010  Lance Fetters (aka. ashikase)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+// Stress the shared control blocks with several application processes
+// NOTE: Host tool; build with:
+//         c++ -O2 -I../Extension -o control_block_test control_block_test.cpp
+//             -x c++ ../Extension/ControlBlock.mm
+//       (older Linux systems may also need -lrt)
+//       Usage: control_block_test [-a <apps>] [-w <writes per app>]
+// NOTE: The parent acts as SpringBoard and writes alternating states to the
+//       block of each child, waiting for every write to be acknowledged
+//       before the next; children act as applications, reading and
+//       acknowledging their block until told to stop.
+
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <vector>
+
+#include "ControlBlock.h"
+
+static double currentTime()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1.0e9;
+}
+
+// NOTE: Runs in the child process; the return value is the exit status.
+static int runApplication(int readyFd, volatile uint32_t *done, unsigned int writes)
+{
+    BGControlBlock *block = createControlBlock(false);
+    if (block == NULL) {
+        fprintf(stderr, "ERROR: [%d] Unable to create control block\n", getpid());
+        return 1;
+    }
+
+    char byte = 1;
+    if (write(readyFd, &byte, 1) != 1)
+        return 1;
+    close(readyFd);
+
+    // Read and acknowledge as the application hooks would, checking that
+    // generations only ever move forward
+    // NOTE: As each write waits for the previous one to be acknowledged, the
+    //       state read must be the one written with the generation read.
+    unsigned long reads = 0;
+    unsigned long acks = 0;
+    uint32_t lastGeneration = 0;
+    bool enabled = false;
+    while (*done == 0) {
+        uint32_t generation = readControlBlockGeneration(block);
+        enabled = readControlBlockEnabled(block);
+        if (generation < lastGeneration) {
+            fprintf(stderr, "ERROR: [%d] Generation went backwards (%u -> %u)\n",
+                getpid(), lastGeneration, generation);
+            return 1;
+        }
+        if (generation != lastGeneration) {
+            if (enabled != ((generation & 1) != 0)) {
+                fprintf(stderr, "ERROR: [%d] State read for generation %u is %s\n",
+                    getpid(), generation, enabled ? "enabled" : "disabled");
+                return 1;
+            }
+            acknowledgeControlBlock(block, generation);
+            ++acks;
+        } else {
+            sched_yield();
+        }
+        lastGeneration = generation;
+        ++reads;
+    }
+
+    __sync_synchronize();
+    enabled = readControlBlockEnabled(block);
+    if (block->generation != writes || enabled != ((writes & 1) != 0)) {
+        fprintf(stderr, "ERROR: [%d] Final state is generation %u, %s; expected %u, %s\n",
+            getpid(), block->generation, enabled ? "enabled" : "disabled",
+            writes, (writes & 1) ? "enabled" : "disabled");
+        return 1;
+    }
+    if (block->version != BG_CONTROL_BLOCK_VERSION) {
+        fprintf(stderr, "ERROR: [%d] Version was overwritten\n", getpid());
+        return 1;
+    }
+
+    if (acks != writes || block->ackGeneration != writes) {
+        fprintf(stderr, "ERROR: [%d] Acknowledged %lu of %u writes (last %u)\n",
+            getpid(), acks, writes, block->ackGeneration);
+        return 1;
+    }
+
+    printf("  [%d] %lu reads, %lu acks\n", getpid(), reads, acks);
+    return 0;
+}
+
+// NOTE: Runs in the parent process; gives up if any app takes over a second.
+static bool waitForAcknowledgements(const std::vector<pid_t> &pids)
+{
+    double deadline = currentTime() + 1.0;
+    for (size_t i = 0; i < pids.size(); ++i) {
+        bool acknowledged = false;
+        while (peekControlBlockAcknowledged(pids[i], &acknowledged) && !acknowledged) {
+            if (currentTime() > deadline)
+                break;
+            sched_yield();
+        }
+        if (!acknowledged) {
+            fprintf(stderr, "ERROR: [%d] Write was not acknowledged\n", pids[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+        "Usage: %s [options]\n"
+        "Options:\n"
+        "  -a <apps>     number of application processes (default: 8)\n"
+        "  -w <writes>   number of writes per application (default: 100000)\n", name);
+}
+
+int main(int argc, char **argv)
+{
+    unsigned int appCount = 8;
+    unsigned int writes = 100000;
+
+    int c;
+    while ((c = getopt(argc, argv, "a:w:")) != -1) {
+        switch (c) {
+            case 'a':
+                appCount = strtoul(optarg, NULL, 10);
+                break;
+            case 'w':
+                writes = strtoul(optarg, NULL, 10);
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (appCount == 0 || writes == 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    // NOTE: Shared with the children; set once all writes are done.
+    void *addr = mmap(NULL, sizeof(uint32_t), PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_ANON, -1, 0);
+    if (addr == MAP_FAILED) {
+        perror("mmap");
+        return 1;
+    }
+    volatile uint32_t *done = reinterpret_cast<volatile uint32_t *>(addr);
+    *done = 0;
+
+    int readyPipe[2];
+    if (pipe(readyPipe) != 0) {
+        perror("pipe");
+        return 1;
+    }
+
+    std::vector<pid_t> pids;
+    fflush(stdout);
+    for (unsigned int i = 0; i < appCount; ++i) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            close(readyPipe[0]);
+            int status = runApplication(readyPipe[1], done, writes);
+            fflush(stdout);
+            _exit(status);
+        } else if (pid < 0) {
+            perror("fork");
+            break;
+        }
+        pids.push_back(pid);
+    }
+    close(readyPipe[1]);
+
+    bool failed = (pids.size() != appCount);
+
+    // Wait for all blocks to be created
+    for (size_t i = 0; i < pids.size(); ++i) {
+        char byte;
+        if (read(readyPipe[0], &byte, 1) != 1) {
+            fprintf(stderr, "ERROR: An application failed to start\n");
+            failed = true;
+            break;
+        }
+    }
+    close(readyPipe[0]);
+
+    double mapTime = 0, writeTime = 0;
+    if (!failed) {
+        // NOTE: The first write to each block also maps it
+        double start = currentTime();
+        for (size_t i = 0; i < pids.size(); ++i)
+            failed |= !writeControlBlockEnabled(pids[i], true);
+        mapTime = currentTime() - start;
+        failed |= !waitForAcknowledgements(pids);
+
+        // NOTE: Timed from each write until it is acknowledged
+        start = currentTime();
+        for (unsigned int w = 2; w <= writes && !failed; ++w) {
+            for (size_t i = 0; i < pids.size(); ++i)
+                failed |= !writeControlBlockEnabled(pids[i], (w & 1) != 0);
+            failed |= !waitForAcknowledgements(pids);
+        }
+        writeTime = currentTime() - start;
+
+        for (size_t i = 0; i < pids.size(); ++i) {
+            bool enabled;
+            if (!peekControlBlockEnabled(pids[i], &enabled) || enabled != ((writes & 1) != 0)) {
+                fprintf(stderr, "ERROR: [%d] Peeked state does not match last write\n", pids[i]);
+                failed = true;
+            }
+        }
+        if (failed)
+            fprintf(stderr, "ERROR: Write to control block failed\n");
+    }
+
+    __sync_synchronize();
+    *done = 1;
+
+    for (size_t i = 0; i < pids.size(); ++i) {
+        if (failed)
+            kill(pids[i], SIGKILL);
+
+        int status;
+        if (waitpid(pids[i], &status, 0) != pids[i] || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+            failed = true;
+
+        // Blocks must not be reachable once the app has exited
+        destroyControlBlock(pids[i]);
+        bool enabled;
+        if (writeControlBlockEnabled(pids[i], true) || peekControlBlockEnabled(pids[i], &enabled)) {
+            fprintf(stderr, "ERROR: [%d] Block is still reachable after exit\n", pids[i]);
+            failed = true;
+        }
+    }
+
+    if (failed) {
+        printf("FAILED\n");
+        return 1;
+    }
+
+    unsigned long total = (unsigned long)appCount * (writes - 1);
+    printf("\nApps: %u, writes: %lu\n", appCount, (unsigned long)appCount * writes);
+    printf("First write (includes mapping): %.2f us/write\n", mapTime * 1.0e6 / appCount);
+    if (total != 0)
+        printf("Later writes: %.2f us/write until acknowledged\n", writeTime * 1.0e6 / total);
+    printf("PASSED\n");
+    return 0;
+}
+
+/* vim: set filetype=cpp sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */
@@ -0,0 +1,285 @@
+/**
+ * Name: Backgrounder
+ * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
+ * Description: allow applications to run in the background
+ * Author: Lance Fetters (aka. ashikase)
+ * Last-modified: 2026-10-17 10:12:45
+ */
+
+/**
+ * Copyright (C) 2008-2010  Lance Fetters (aka. ashikase)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+// Summarise a lifecycle ledger written by the Backgrounder extension
+// NOTE: Host tool; build with:
+//         c++ -I../Common -o ledger_summary ledger_summary.cpp
+//       Usage: ledger_summary jp.ashikase.backgrounder.ledger [...]
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "LedgerFormat.h"
+
+struct AppSummary {
+    unsigned launches;
+    unsigned resumes;
+    unsigned backgroundings;
+    unsigned exits;
+    unsigned abnormalExits;
+    unsigned abnormalExitsInBackground;
+    unsigned relaunches;
+    unsigned toggles;
+    unsigned watchdogsSuppressed;
+    double backgroundSeconds;
+    double longestBackgroundSeconds;
+    unsigned latencyCount;
+    unsigned long latencyTotalMsecs;
+    unsigned latencyMaxMsecs;
+
+    AppSummary() { memset(this, 0, sizeof(*this)); }
+};
+
+// Per-app state within a session
+struct SessionAppState {
+    bool inBackground;
+    uint64_t backgroundedAt;
+
+    SessionAppState() : inBackground(false), backgroundedAt(0) {}
+};
+
+static std::map<std::string, AppSummary> summaries_;
+static unsigned long droppedEvents_ = 0;
+static unsigned sessionCount_ = 0;
+
+//==============================================================================
+
+class Session {
+    public:
+        Session(const BGLedgerSessionHeader &header) : header_(header) {}
+
+        void setName(uint32_t appId, const std::string &name) {
+            if (appId >= names_.size())
+                names_.resize(appId + 1);
+            names_[appId] = name;
+        }
+
+        void handleEvent(const BGLedgerEvent &event);
+
+    private:
+        BGLedgerSessionHeader header_;
+        std::vector<std::string> names_;
+        std::map<uint32_t, SessionAppState> states_;
+
+        double secondsBetween(uint64_t from, uint64_t to) const {
+            return (double)(to - from) * header_.timebaseNumer / header_.timebaseDenom / 1.0e9;
+        }
+
+        void endBackground(AppSummary &summary, SessionAppState &state, uint64_t timestamp) {
+            if (state.inBackground) {
+                double seconds = secondsBetween(state.backgroundedAt, timestamp);
+                summary.backgroundSeconds += seconds;
+                summary.longestBackgroundSeconds = std::max(summary.longestBackgroundSeconds, seconds);
+                state.inBackground = false;
+            }
+        }
+};
+
+void Session::handleEvent(const BGLedgerEvent &event)
+{
+    std::string name = (event.appId < names_.size() && !names_[event.appId].empty()) ?
+        names_[event.appId] : "(unknown)";
+    AppSummary &summary = summaries_[name];
+    SessionAppState &state = states_[event.appId];
+
+    switch (event.type) {
+        case BGLedgerEventLaunch:
+            if (event.arg)
+                ++summary.resumes;
+            else
+                ++summary.launches;
+            endBackground(summary, state, event.timestamp);
+            break;
+        case BGLedgerEventDeactivate:
+            if (event.arg) {
+                ++summary.backgroundings;
+                state.inBackground = true;
+                state.backgroundedAt = event.timestamp;
+            }
+            break;
+        case BGLedgerEventExit:
+            ++summary.exits;
+            endBackground(summary, state, event.timestamp);
+            break;
+        case BGLedgerEventExitAbnormally:
+            ++summary.abnormalExits;
+            if (state.inBackground)
+                ++summary.abnormalExitsInBackground;
+            break;
+        case BGLedgerEventSetBackgrounding:
+            ++summary.toggles;
+            if (!event.arg)
+                endBackground(summary, state, event.timestamp);
+            break;
+        case BGLedgerEventWatchdogTimer:
+            if (event.arg & 0x100)
+                ++summary.watchdogsSuppressed;
+            break;
+        case BGLedgerEventRelaunch:
+            ++summary.relaunches;
+            break;
+        case BGLedgerEventToggleLatency:
+            ++summary.latencyCount;
+            summary.latencyTotalMsecs += event.arg;
+            summary.latencyMaxMsecs = std::max(summary.latencyMaxMsecs, (unsigned)event.arg);
+            break;
+        default:
+            break;
+    }
+}
+
+//==============================================================================
+
+static bool readLedger(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        fprintf(stderr, "ERROR: Unable to open %s\n", path);
+        return false;
+    }
+
+    bool ret = true;
+    Session *session = NULL;
+
+    uint32_t magic;
+    while (fread(&magic, sizeof(magic), 1, file) == 1) {
+        fseek(file, -(long)sizeof(magic), SEEK_CUR);
+
+        if (magic == BG_LEDGER_MAGIC_SESSION) {
+            BGLedgerSessionHeader header;
+            if (fread(&header, sizeof(header), 1, file) != 1 || header.version != BG_LEDGER_VERSION
+                    || header.timebaseDenom == 0) {
+                ret = false;
+                break;
+            }
+            delete session;
+            session = new Session(header);
+            ++sessionCount_;
+        } else if (magic == BG_LEDGER_MAGIC_CHUNK && session != NULL) {
+            BGLedgerChunkHeader chunk;
+            if (fread(&chunk, sizeof(chunk), 1, file) != 1) {
+                ret = false;
+                break;
+            }
+            droppedEvents_ += chunk.droppedCount;
+
+            for (uint32_t i = 0; ret && i < chunk.nameCount; ++i) {
+                BGLedgerNameEntry entry;
+                std::vector<char> buf;
+                if (fread(&entry, sizeof(entry), 1, file) != 1 || entry.length > 1024) {
+                    ret = false;
+                } else {
+                    buf.resize(entry.length);
+                    if (entry.length != 0 && fread(&buf[0], entry.length, 1, file) != 1)
+                        ret = false;
+                    else
+                        session->setName(entry.appId, std::string(buf.begin(), buf.end()));
+                }
+            }
+
+            for (uint32_t i = 0; ret && i < chunk.eventCount; ++i) {
+                BGLedgerEvent event;
+                if (fread(&event, sizeof(event), 1, file) != 1)
+                    ret = false;
+                else
+                    session->handleEvent(event);
+            }
+            if (!ret)
+                break;
+        } else {
+            // Unknown block or chunk without session; cannot continue
+            ret = false;
+            break;
+        }
+    }
+
+    if (!ret)
+        fprintf(stderr, "WARNING: %s is truncated or corrupt; summary is partial\n", path);
+
+    delete session;
+    fclose(file);
+    return ret;
+}
+
+static bool compareByBackgroundTime(const std::pair<std::string, AppSummary> &a,
+    const std::pair<std::string, AppSummary> &b)
+{
+    return a.second.backgroundSeconds > b.second.backgroundSeconds;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <ledger file> [...]\n", argv[0]);
+        return 1;
+    }
+
+    for (int i = 1; i < argc; ++i)
+        readLedger(argv[i]);
+
+    std::vector<std::pair<std::string, AppSummary> > apps(summaries_.begin(), summaries_.end());
+    std::sort(apps.begin(), apps.end(), compareByBackgroundTime);
+
+    printf("Sessions: %u, dropped events: %lu\n\n", sessionCount_, droppedEvents_);
+    printf("%-40s %7s %7s %7s %10s %10s %7s %7s %7s %7s %9s %9s\n",
+        "Application", "Launch", "Resume", "BgCount", "BgTotal(s)", "BgMax(s)",
+        "Crash", "CrashBg", "Relnch", "WdSupp", "ToggleAvg", "ToggleMax");
+    for (size_t i = 0; i < apps.size(); ++i) {
+        const AppSummary &s = apps[i].second;
+        printf("%-40s %7u %7u %7u %10.1f %10.1f %7u %7u %7u %7u %7lums %7ums\n",
+            apps[i].first.c_str(), s.launches, s.resumes, s.backgroundings,
+            s.backgroundSeconds, s.longestBackgroundSeconds, s.abnormalExits,
+            s.abnormalExitsInBackground, s.relaunches, s.watchdogsSuppressed,
+            (s.latencyCount != 0) ? s.latencyTotalMsecs / s.latencyCount : 0,
+            s.latencyMaxMsecs);
+    }
+
+    return 0;
+}
+
+/* vim: set filetype=cpp sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */
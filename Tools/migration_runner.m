@@ -0,0 +1,203 @@
+/**
+ * Name: Backgrounder
+ * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
+ * Description: allow applications to run in the background
+ * Author: Lance Fetters (aka. ashikase)
+ * Last-modified: 2026-10-17 22:41:07
+ */
+
+/**
+ * Copyright (C) 2008-2010  Lance Fetters (aka. ashikase)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+// Run the Updater migrations against preference fixtures, without a device
+// NOTE: Host tool; build on Linux (GNUstep) with:
+//         clang -O2 `gnustep-config --objc-flags` -I../Common -I../Updater
+//             -o migration_runner migration_runner.m ../Updater/Migrations.m
+//             `gnustep-config --base-libs`
+//       or on OS X with:
+//         clang -O2 -fno-objc-arc -framework Foundation -I../Common -I../Updater
+//             -o migration_runner migration_runner.m ../Updater/Migrations.m
+//       Usage: migration_runner [-r <count>] <fixture> [...]
+//              migration_runner [-r <count>] -s <apps>
+//       For each fixture "<name>.plist", the migrated preferences are compared
+//       with "<name>-expected.plist" (see fixtures/migrations). With -s, a
+//       pre-432 configuration with the given number of apps is generated and
+//       only timed.
+// NOTE: As on device, the version number is not part of the migrations and
+//       so is left unchanged.
+
+#import <Foundation/Foundation.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#import "Migrations.h"
+#import "PreferenceConstants.h"
+
+// Stand-in for SpringBoardServices
+// NOTE: Reports the media players of an iPhone running firmware 3.x.
+NSString * SBSCopyLocalizedApplicationNameForDisplayIdentifier(NSString *identifier)
+{
+    if ([identifier isEqualToString:@"com.apple.mobileipod-AudioPlayer"])
+        return [@"Music" retain];
+    if ([identifier isEqualToString:@"com.apple.mobileipod-VideoPlayer"])
+        return [@"Videos" retain];
+    return nil;
+}
+
+static double currentTime()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1.0e9;
+}
+
+// Returns the migrated preferences (autoreleased) and the time per run
+static NSDictionary *migrate(NSDictionary *input, unsigned int repeat, double *duration)
+{
+    NSMutableDictionary *prefs = nil;
+    double start = currentTime();
+    for (unsigned int i = 0; i < repeat; i++) {
+        NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+        [prefs release];
+        prefs = [[NSMutableDictionary alloc] initWithDictionary:input];
+        applyMigrations(prefs, storedVersionOfPreferences(prefs));
+        [pool release];
+    }
+    *duration = (currentTime() - start) / repeat;
+    return [prefs autorelease];
+}
+
+static BOOL runFixture(NSString *path, unsigned int repeat)
+{
+    NSDictionary *input = [NSDictionary dictionaryWithContentsOfFile:path];
+    NSString *expectedPath = [[[path stringByDeletingPathExtension]
+        stringByAppendingString:@"-expected"] stringByAppendingPathExtension:@"plist"];
+    NSDictionary *expected = [NSDictionary dictionaryWithContentsOfFile:expectedPath];
+    if (input == nil || expected == nil) {
+        fprintf(stderr, "ERROR: Unable to load %s or its expected result\n", [path UTF8String]);
+        return NO;
+    }
+
+    double duration;
+    NSDictionary *prefs = migrate(input, repeat, &duration);
+    BOOL passed = [prefs isEqualToDictionary:expected];
+    printf("%-4s %-40s %10.1f us\n", passed ? "ok" : "FAIL",
+        [[path lastPathComponent] UTF8String], duration * 1.0e6);
+    if (!passed)
+        printf("Result:\n%s\n", [[prefs description] UTF8String]);
+    return passed;
+}
+
+static BOOL runSynthetic(unsigned int appCount, unsigned int repeat)
+{
+    // Pre-432 settings: every app always enabled, every third blacklisted
+    NSMutableArray *enabledApps = [NSMutableArray arrayWithCapacity:appCount];
+    NSMutableArray *blacklistedApps = [NSMutableArray array];
+    for (unsigned int i = 0; i < appCount; i++) {
+        NSString *displayId = [NSString stringWithFormat:@"com.example.synthetic.app%05u", i];
+        [enabledApps addObject:displayId];
+        if (i % 3 == 0)
+            [blacklistedApps addObject:displayId];
+    }
+    NSDictionary *input = [NSDictionary dictionaryWithObjectsAndKeys:
+        [NSNumber numberWithBool:YES], kBadgeEnabled,
+        enabledApps, kEnabledApps,
+        blacklistedApps, kBlacklistedApps,
+        nil];
+
+    double duration;
+    NSDictionary *prefs = migrate(input, repeat, &duration);
+    BOOL passed = ([[prefs objectForKey:kOverrides] count] == appCount);
+    printf("%-4s %-40s %10.1f us\n", passed ? "ok" : "FAIL",
+        [[NSString stringWithFormat:@"synthetic (%u apps)", appCount] UTF8String],
+        duration * 1.0e6);
+    return passed;
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+        "Usage: %s [options] <fixture> [...]\n"
+        "       %s [options] -s <apps>\n"
+        "Options:\n"
+        "  -r <count>    migrate each fixture count times (default: 100)\n", name, name);
+}
+
+int main(int argc, char **argv)
+{
+    NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+
+    unsigned int repeat = 100;
+    unsigned int syntheticApps = 0;
+
+    int c;
+    while ((c = getopt(argc, argv, "r:s:")) != -1) {
+        switch (c) {
+            case 'r':
+                repeat = strtoul(optarg, NULL, 10);
+                break;
+            case 's':
+                syntheticApps = strtoul(optarg, NULL, 10);
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (repeat == 0 || (optind == argc && syntheticApps == 0)) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    unsigned int failed = 0;
+    for (int i = optind; i < argc; i++) {
+        NSString *path = [NSString stringWithUTF8String:argv[i]];
+        if ([path hasSuffix:@"-expected.plist"])
+            // Allow the fixture directory to be passed via a wildcard
+            continue;
+        if (!runFixture(path, repeat))
+            failed++;
+    }
+    if (syntheticApps != 0 && !runSynthetic(syntheticApps, repeat))
+        failed++;
+
+    [pool release];
+    return (failed == 0) ? 0 : 1;
+}
+
+/* vim: set filetype=objc sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */
@@ -0,0 +1,181 @@
+/**
+ * Name: Backgrounder
+ * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
+ * Description: allow applications to run in the background
+ * Author: Lance Fetters (aka. ashikase)
+ * Last-modified: 2026-10-17 22:25:14
+ */
+
+/**
+ * Copyright (C) 2008-2010  Lance Fetters (aka. ashikase)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+// Measure the cost of posting notifications with the "Backgrounder" method's
+// notification filter in its various states
+// NOTE: Build on OS X (or on device) with:
+//         clang -O2 -framework Foundation -o notification_bench notification_bench.m
+//       Usage: notification_bench [iterations] [observers]
+// NOTE: The filter is installed in the same way as by the extension (the
+//       method implementation is replaced and the original called from the
+//       replacement); no MobileSubstrate is needed. The shared memory read
+//       of the backgrounding state is stood in for by a volatile read with a
+//       memory barrier.
+
+#import <Foundation/Foundation.h>
+
+#include <libkern/OSAtomic.h>
+#include <mach/mach_time.h>
+#include <objc/runtime.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// NOTE: Stand-ins for the UIKit constants
+static NSString *const WillResignActiveNotification = @"UIApplicationWillResignActiveNotification";
+static NSString *const DidBecomeActiveNotification = @"UIApplicationDidBecomeActiveNotification";
+
+static volatile uint32_t enabled_ = 0;
+static IMP original_ = NULL;
+
+static inline BOOL isBackgroundingEnabled()
+{
+    OSMemoryBarrier();
+    return enabled_ != 0;
+}
+
+// Filter as it was before being made switchable (installed for the life of the app)
+static void postWithStringCompare(id self, SEL _cmd, NSString *name, id object, NSDictionary *userInfo)
+{
+    if (isBackgroundingEnabled()) {
+        if ([name isEqualToString:WillResignActiveNotification]
+                || [name isEqualToString:DidBecomeActiveNotification])
+            return;
+    }
+
+    ((void (*)(id, SEL, NSString *, id, NSDictionary *))original_)(self, _cmd, name, object, userInfo);
+}
+
+// Filter as it is now (only installed while backgrounding is enabled)
+static void postWithPointerCompare(id self, SEL _cmd, NSString *name, id object, NSDictionary *userInfo)
+{
+    if ((name == WillResignActiveNotification || name == DidBecomeActiveNotification)
+            && isBackgroundingEnabled())
+        return;
+
+    ((void (*)(id, SEL, NSString *, id, NSDictionary *))original_)(self, _cmd, name, object, userInfo);
+}
+
+@interface BenchObserver : NSObject
+- (void)observe:(NSNotification *)notification;
+@end
+
+@implementation BenchObserver
+- (void)observe:(NSNotification *)notification {}
+@end
+
+//==============================================================================
+
+static double measure(NSNotificationCenter *center, NSString *name, unsigned iterations)
+{
+    mach_timebase_info_data_t timebase;
+    mach_timebase_info(&timebase);
+
+    uint64_t start = mach_absolute_time();
+    for (unsigned i = 0; i < iterations; ++i) {
+        NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+        [center postNotificationName:name object:nil userInfo:nil];
+        [pool drain];
+    }
+    uint64_t elapsed = mach_absolute_time() - start;
+
+    // Nanoseconds per post
+    return (double)elapsed * timebase.numer / timebase.denom / iterations;
+}
+
+int main(int argc, char **argv)
+{
+    NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+
+    unsigned iterations = (argc > 1) ? strtoul(argv[1], NULL, 10) : 1000000;
+    unsigned observerCount = (argc > 2) ? strtoul(argv[2], NULL, 10) : 0;
+    if (iterations == 0) {
+        fprintf(stderr, "Usage: %s [iterations] [observers]\n", argv[0]);
+        return 1;
+    }
+
+    // NOTE: A private center is used so that no system observers interfere.
+    NSNotificationCenter *center = [[NSNotificationCenter alloc] init];
+    NSString *name = @"BenchNotification";
+    NSMutableArray *observers = [NSMutableArray array];
+    for (unsigned i = 0; i < observerCount; ++i) {
+        BenchObserver *observer = [[BenchObserver alloc] init];
+        [center addObserver:observer selector:@selector(observe:) name:name object:nil];
+        [observers addObject:observer];
+        [observer release];
+    }
+
+    Method method = class_getInstanceMethod([NSNotificationCenter class],
+        @selector(postNotificationName:object:userInfo:));
+    original_ = method_getImplementation(method);
+
+    printf("%u posts, %u observer(s); nanoseconds per post:\n", iterations, observerCount);
+
+    // Warm up
+    measure(center, name, iterations / 10 + 1);
+
+    printf("  no filter:                      %8.1f\n", measure(center, name, iterations));
+
+    method_setImplementation(method, (IMP)postWithStringCompare);
+    enabled_ = 0;
+    printf("  always installed, disabled:     %8.1f\n", measure(center, name, iterations));
+    enabled_ = 1;
+    printf("  always installed, enabled:      %8.1f\n", measure(center, name, iterations));
+
+    // NOTE: While backgrounding is disabled the original implementation is
+    //       restored, which is the same as having no filter.
+    method_setImplementation(method, original_);
+    enabled_ = 0;
+    printf("  switchable, disabled:           %8.1f\n", measure(center, name, iterations));
+    method_setImplementation(method, (IMP)postWithPointerCompare);
+    enabled_ = 1;
+    printf("  switchable, enabled:            %8.1f\n", measure(center, name, iterations));
+
+    method_setImplementation(method, original_);
+    for (BenchObserver *observer in observers)
+        [center removeObserver:observer];
+    [center release];
+
+    [pool drain];
+    return 0;
+}
+
+/* vim: set filetype=objc sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */
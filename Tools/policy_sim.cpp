@@ -0,0 +1,457 @@
+/**
+ * Name: Backgrounder
+ * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
+ * Description: allow applications to run in the background
+ * Author: Lance Fetters (aka. ashikase)
+ * Last-modified: 2026-10-17 14:02:44
+ */
+
+/**
+ * Copyright (C) 2008-2010  Lance Fetters (aka. ashikase)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+// Replay application lifecycle traces through the backgrounding policy engine
+// NOTE: Host tool; build with:
+//         c++ -O2 -I../Common -I../Extension -o policy_sim policy_sim.cpp
+//             -x c++ ../Extension/PolicyEngine.mm
+//       Usage: policy_sim [options] <trace file> [...]
+//              policy_sim [options] -s <apps>:<events>
+//       Trace files are either lifecycle ledgers (as written by the extension)
+//       or text files with one "<display identifier> <event>" per line, where
+//       event is one of launch, resume, deactivate, enable, disable, crash,
+//       exit, relaunch, toggle or activate; lines starting with '#' are
+//       ignored.
+// NOTE: "toggle" and "activate" (launch or resume) are resolved according to
+//       the app's state at the time of replay.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "LedgerFormat.h"
+#include "PolicyEngine.h"
+
+// Trace-only events; resolved at replay time
+#define kEventToggle   BGPolicyEventCount
+#define kEventActivate (BGPolicyEventCount + 1)
+#define kNumEventNames (BGPolicyEventCount + 2)
+
+struct TraceEvent {
+    uint32_t app;
+    uint32_t event;
+};
+
+static std::vector<TraceEvent> events_;
+static std::map<std::string, uint32_t> appIndices_;
+static std::vector<std::string> appNames_;
+
+static const char * const eventNames_[] = {
+    "launch", "resume", "deactivate", "enable", "disable", "crash", "exit", "relaunch", "toggle", "activate"
+};
+
+static const char * const stateNames_[BGPolicyStateCount] = {
+    "NotRunning", "Foreground", "Background", "Suspended"
+};
+
+static const char * const actionNames_[] = {
+    "EnableBackgrounding", "DisableBackgrounding", "UpdateIndicator", "KeepRunning",
+    "Quit", "StartThrottling", "ShowFallbackBadge", "PermitRelaunch", "Relaunch"
+};
+#define kNumActions (sizeof(actionNames_) / sizeof(actionNames_[0]))
+
+//==============================================================================
+
+static uint32_t indexForApp(const std::string &name)
+{
+    std::map<std::string, uint32_t>::iterator it = appIndices_.find(name);
+    if (it != appIndices_.end())
+        return it->second;
+
+    uint32_t index = appNames_.size();
+    appIndices_[name] = index;
+    appNames_.push_back(name);
+    return index;
+}
+
+static void addEvent(uint32_t app, uint32_t event)
+{
+    TraceEvent e = {app, event};
+    events_.push_back(e);
+}
+
+static bool readTextTrace(FILE *file, const char *path)
+{
+    char line[512];
+    unsigned lineNumber = 0;
+    while (fgets(line, sizeof(line), file) != NULL) {
+        ++lineNumber;
+        char name[256], event[32];
+        if (line[0] == '#' || sscanf(line, "%255s %31s", name, event) != 2)
+            continue;
+
+        uint32_t type;
+        for (type = 0; type < kNumEventNames; ++type)
+            if (strcmp(event, eventNames_[type]) == 0)
+                break;
+        if (type == kNumEventNames) {
+            fprintf(stderr, "WARNING: %s:%u: unknown event \"%s\"\n", path, lineNumber, event);
+            continue;
+        }
+
+        if (type == BGPolicyEventCrash) {
+            // NOTE: SpringBoard always sees an exit following a crash
+            addEvent(indexForApp(name), BGPolicyEventCrash);
+            addEvent(indexForApp(name), BGPolicyEventExit);
+        } else {
+            addEvent(indexForApp(name), type);
+        }
+    }
+    return true;
+}
+
+static bool readLedgerTrace(FILE *file, const char *path)
+{
+    bool ret = true;
+    std::vector<uint32_t> sessionApps;
+
+    uint32_t magic;
+    while (ret && fread(&magic, sizeof(magic), 1, file) == 1) {
+        fseek(file, -(long)sizeof(magic), SEEK_CUR);
+
+        if (magic == BG_LEDGER_MAGIC_SESSION) {
+            // NOTE: App IDs are only meaningful within a session
+            BGLedgerSessionHeader header;
+            if (fread(&header, sizeof(header), 1, file) != 1 || header.version != BG_LEDGER_VERSION)
+                ret = false;
+            sessionApps.clear();
+        } else if (magic == BG_LEDGER_MAGIC_CHUNK) {
+            BGLedgerChunkHeader chunk;
+            if (fread(&chunk, sizeof(chunk), 1, file) != 1) {
+                ret = false;
+                break;
+            }
+
+            for (uint32_t i = 0; ret && i < chunk.nameCount; ++i) {
+                BGLedgerNameEntry entry;
+                std::vector<char> buf;
+                if (fread(&entry, sizeof(entry), 1, file) != 1 || entry.length > 1024) {
+                    ret = false;
+                } else {
+                    buf.resize(entry.length);
+                    if (entry.length != 0 && fread(&buf[0], entry.length, 1, file) != 1) {
+                        ret = false;
+                    } else {
+                        if (entry.appId >= sessionApps.size())
+                            sessionApps.resize(entry.appId + 1, (uint32_t)-1);
+                        sessionApps[entry.appId] = indexForApp(std::string(buf.begin(), buf.end()));
+                    }
+                }
+            }
+
+            for (uint32_t i = 0; ret && i < chunk.eventCount; ++i) {
+                BGLedgerEvent event;
+                if (fread(&event, sizeof(event), 1, file) != 1) {
+                    ret = false;
+                    break;
+                }
+                if (event.appId >= sessionApps.size() || sessionApps[event.appId] == (uint32_t)-1)
+                    continue;
+
+                uint32_t app = sessionApps[event.appId];
+                switch (event.type) {
+                    case BGLedgerEventLaunch:
+                        addEvent(app, event.arg ? BGPolicyEventResume : BGPolicyEventLaunch);
+                        break;
+                    case BGLedgerEventDeactivate:
+                        addEvent(app, BGPolicyEventDeactivate);
+                        break;
+                    case BGLedgerEventExit:
+                        addEvent(app, BGPolicyEventExit);
+                        break;
+                    case BGLedgerEventExitAbnormally:
+                        addEvent(app, BGPolicyEventCrash);
+                        break;
+                    case BGLedgerEventSetBackgrounding:
+                        addEvent(app, event.arg ? BGPolicyEventEnable : BGPolicyEventDisable);
+                        break;
+                    case BGLedgerEventRelaunch:
+                        addEvent(app, BGPolicyEventRelaunchCheck);
+                        break;
+                    default:
+                        break;
+                }
+            }
+        } else {
+            ret = false;
+        }
+    }
+
+    if (!ret)
+        fprintf(stderr, "WARNING: %s is truncated or corrupt; trace is partial\n", path);
+    return ret;
+}
+
+static bool readTrace(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        fprintf(stderr, "ERROR: Unable to open %s\n", path);
+        return false;
+    }
+
+    uint32_t magic = 0;
+    bool isLedger = (fread(&magic, sizeof(magic), 1, file) == 1 && magic == BG_LEDGER_MAGIC_SESSION);
+    rewind(file);
+
+    bool ret = isLedger ? readLedgerTrace(file, path) : readTextTrace(file, path);
+    fclose(file);
+    return ret;
+}
+
+//==============================================================================
+
+// NOTE: A fixed generator is used so that runs are reproducible.
+static uint32_t random_ = 1;
+
+static inline uint32_t nextRandom(uint32_t limit)
+{
+    random_ = random_ * 1103515245 + 12345;
+    return (random_ >> 8) % limit;
+}
+
+// Generate a plausible trace: the user repeatedly switches to a random app,
+// sometimes toggles backgrounding, and then leaves it (or it crashes)
+static void generateTrace(unsigned appCount, unsigned eventCount)
+{
+    char name[32];
+    for (unsigned i = 0; i < appCount; ++i) {
+        snprintf(name, sizeof(name), "sim.app.%u", i);
+        indexForApp(name);
+    }
+
+    while (events_.size() < eventCount) {
+        uint32_t app = nextRandom(appCount);
+        addEvent(app, kEventActivate);
+        if (nextRandom(3) == 0)
+            addEvent(app, kEventToggle);
+        if (nextRandom(50) == 0) {
+            addEvent(app, BGPolicyEventCrash);
+            addEvent(app, BGPolicyEventExit);
+            addEvent(app, BGPolicyEventRelaunchCheck);
+        } else {
+            addEvent(app, BGPolicyEventDeactivate);
+        }
+    }
+}
+
+//==============================================================================
+
+static BGPolicyInput defaultInput_;
+static bool randomPolicies_ = false;
+
+static BGPolicyInput inputForApp(uint32_t app)
+{
+    BGPolicyInput input = defaultInput_;
+    if (randomPolicies_) {
+        // NOTE: Derived from the app index so that policies are stable
+        uint32_t bits = app * 2654435761u;
+        bool throttled;
+        input.method = bgResolveMethod((BGBackgroundingMethod)(bits % 5), input.firmware3x,
+            false, (bits >> 3) & 1, &throttled);
+        input.throttled = throttled;
+        input.fallbackToNative = (bits >> 4) & 1;
+        input.persistent = (bits >> 5) & 1;
+        input.enableAtLaunch = ((bits >> 6) & 3) == 0;
+    }
+    return input;
+}
+
+static double currentTime()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1.0e9;
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+        "Usage: %s [options] <trace file> [...]\n"
+        "       %s [options] -s <apps>:<events>\n"
+        "Options:\n"
+        "  -m <method>   off, native, backgrounder, autodetect or throttled (default: backgrounder)\n"
+        "  -3            simulate firmware 3.x\n"
+        "  -p            vary policy settings per app\n"
+        "  -r <count>    replay the trace count times (default: 10)\n", name, name);
+}
+
+int main(int argc, char **argv)
+{
+    // NOTE: Defaults match those in Defaults.plist
+    BGBackgroundingMethod storedMethod = BGBackgroundingMethodBackgrounder;
+    defaultInput_.fallbackToNative = true;
+    defaultInput_.persistent = true;
+    defaultInput_.enableAtLaunch = false;
+    defaultInput_.statusBarIconEnabled = true;
+    defaultInput_.fastAppSwitchingEnabled = true;
+    defaultInput_.forceFastAppSwitching = false;
+    defaultInput_.firmware3x = false;
+
+    unsigned repeat = 10;
+    unsigned synthApps = 0, synthEvents = 0;
+    std::vector<const char *> paths;
+
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        if (strcmp(arg, "-m") == 0 && i + 1 < argc) {
+            static const char * const methods[] = {"off", "native", "backgrounder", "autodetect", "throttled"};
+            const char *value = argv[++i];
+            unsigned m;
+            for (m = 0; m < 5; ++m)
+                if (strcmp(value, methods[m]) == 0)
+                    break;
+            if (m == 5) {
+                usage(argv[0]);
+                return 1;
+            }
+            storedMethod = (BGBackgroundingMethod)m;
+        } else if (strcmp(arg, "-3") == 0) {
+            defaultInput_.firmware3x = true;
+        } else if (strcmp(arg, "-p") == 0) {
+            randomPolicies_ = true;
+        } else if (strcmp(arg, "-r") == 0 && i + 1 < argc) {
+            repeat = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(arg, "-s") == 0 && i + 1 < argc) {
+            if (sscanf(argv[++i], "%u:%u", &synthApps, &synthEvents) != 2 || synthApps == 0) {
+                usage(argv[0]);
+                return 1;
+            }
+        } else if (arg[0] == '-') {
+            usage(argv[0]);
+            return 1;
+        } else {
+            paths.push_back(arg);
+        }
+    }
+
+    if (paths.empty() && synthApps == 0) {
+        usage(argv[0]);
+        return 1;
+    }
+    if (repeat == 0)
+        repeat = 1;
+
+    bool throttled;
+    defaultInput_.method = bgResolveMethod(storedMethod, defaultInput_.firmware3x, false, true, &throttled);
+    defaultInput_.throttled = throttled;
+
+    for (size_t i = 0; i < paths.size(); ++i)
+        readTrace(paths[i]);
+    if (synthApps != 0)
+        generateTrace(synthApps, synthEvents);
+
+    size_t appCount = appNames_.size();
+    std::vector<BGPolicyInput> inputs(appCount);
+    for (size_t i = 0; i < appCount; ++i)
+        inputs[i] = inputForApp(i);
+
+    // Replay
+    unsigned long actionCounts[kNumActions] = {0};
+    unsigned long rejected = 0;
+    std::vector<BGPolicyRecord> records(appCount);
+
+    double start = currentTime();
+    for (unsigned pass = 0; pass < repeat; ++pass) {
+        for (size_t i = 0; i < appCount; ++i) {
+            records[i].state = BGPolicyStateNotRunning;
+            records[i].backgroundingEnabled = false;
+            records[i].permittedToRelaunch = false;
+        }
+
+        for (size_t i = 0; i < events_.size(); ++i) {
+            const TraceEvent &e = events_[i];
+            BGPolicyRecord &record = records[e.app];
+            uint32_t event = e.event;
+            if (event == kEventToggle)
+                event = record.backgroundingEnabled ? BGPolicyEventDisable : BGPolicyEventEnable;
+            else if (event == kEventActivate)
+                event = (record.state == BGPolicyStateNotRunning) ? BGPolicyEventLaunch : BGPolicyEventResume;
+
+            unsigned actions = bgPolicyTransition(&record, (BGPolicyEvent)event, inputs[e.app]);
+            if (pass == 0) {
+                if (actions & BGPolicyActionRejected)
+                    ++rejected;
+                else
+                    for (unsigned a = 0; a < kNumActions; ++a)
+                        if (actions & (1u << a))
+                            ++actionCounts[a];
+            }
+        }
+    }
+    double elapsed = currentTime() - start;
+
+    unsigned long stateCounts[BGPolicyStateCount] = {0};
+    unsigned long enabledCount = 0;
+    for (size_t i = 0; i < appCount; ++i) {
+        ++stateCounts[records[i].state];
+        if (records[i].backgroundingEnabled)
+            ++enabledCount;
+    }
+
+    unsigned long total = (unsigned long)events_.size() * repeat;
+    printf("Apps: %lu, events: %lu, passes: %u\n", (unsigned long)appCount, (unsigned long)events_.size(), repeat);
+    printf("Rejected events (invalid in current state): %lu\n\n", rejected);
+
+    printf("Actions (per pass):\n");
+    for (unsigned a = 0; a < kNumActions; ++a)
+        printf("  %-22s %10lu\n", actionNames_[a], actionCounts[a]);
+
+    printf("\nFinal states:\n");
+    for (unsigned s = 0; s < BGPolicyStateCount; ++s)
+        printf("  %-22s %10lu\n", stateNames_[s], stateCounts[s]);
+    printf("  %-22s %10lu\n", "(backgrounding enabled)", enabledCount);
+
+    if (total != 0 && elapsed > 0)
+        printf("\nThroughput: %.0f decisions/s (%.1f ns/decision)\n",
+            total / elapsed, elapsed * 1.0e9 / total);
+
+    return 0;
+}
+
+/* vim: set filetype=cpp sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */
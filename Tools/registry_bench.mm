@@ -0,0 +1,174 @@
+/**
+ * Name: Backgrounder
+ * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
+ * Description: allow applications to run in the background
+ * Author: Lance Fetters (aka. ashikase)
+ * Last-modified: 2026-10-17 22:39:59
+ */
+
+/**
+ * Copyright (C) 2008-2010  Lance Fetters (aka. ashikase)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+// Compare the app registry with the arrays of display identifiers it replaced
+// NOTE: Build on OS X (or on device) with:
+//         clang++ -O2 -fno-objc-arc -framework Foundation -I../Common -I../Extension
+//             -o registry_bench registry_bench.mm ../Extension/AppRegistry.mm
+//       Usage: registry_bench [apps] [lookups]
+// NOTE: Lookups use separate copies of the identifiers, as the strings passed
+//       to the hooks by SpringBoard are rarely the ones that were stored.
+
+#import <Foundation/Foundation.h>
+
+#include <mach/mach_time.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#import "AppRegistry.h"
+
+static mach_timebase_info_data_t timebase_;
+
+static inline double nanosecondsSince(uint64_t start)
+{
+    return (double)(mach_absolute_time() - start) * timebase_.numer / timebase_.denom;
+}
+
+// NOTE: Shared prefixes make string compares as costly as for real identifiers.
+static NSArray *createIdentifiers(unsigned count)
+{
+    NSMutableArray *identifiers = [[NSMutableArray alloc] initWithCapacity:count];
+    for (unsigned i = 0; i < count; ++i)
+        [identifiers addObject:[NSString stringWithFormat:@"com.example.synthetic.app%05u", i]];
+    return identifiers;
+}
+
+int main(int argc, char **argv)
+{
+    NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+
+    unsigned appCount = (argc > 1) ? strtoul(argv[1], NULL, 10) : 1000;
+    unsigned lookups = (argc > 2) ? strtoul(argv[2], NULL, 10) : 1000000;
+    if (appCount == 0 || lookups == 0) {
+        fprintf(stderr, "Usage: %s [apps] [lookups]\n", argv[0]);
+        return 1;
+    }
+
+    mach_timebase_info(&timebase_);
+
+    NSArray *identifiers = createIdentifiers(appCount);
+    NSArray *queries = createIdentifiers(appCount);
+
+    printf("%u apps, %u lookups; nanoseconds per operation:\n", appCount, lookups);
+
+    // Boot: record the state of every installed app (every other one enabled)
+    uint64_t start = mach_absolute_time();
+    NSMutableArray *enabledApps = [[NSMutableArray alloc] init];
+    for (unsigned i = 0; i < appCount; i += 2)
+        [enabledApps addObject:[identifiers objectAtIndex:i]];
+    double arrayFill = nanosecondsSince(start);
+
+    start = mach_absolute_time();
+    for (unsigned i = 0; i < appCount; i += 2)
+        setAppState([identifiers objectAtIndex:i], BGAppStateBackgroundingEnabled, YES);
+    double registryFill = nanosecondsSince(start);
+
+    printf("  fill, array:                    %10.1f\n", arrayFill / appCount);
+    printf("  fill, registry:                 %10.1f\n", registryFill / appCount);
+
+    // Membership tests, as made by the hooks for each app event
+    unsigned arrayHits = 0, registryHits = 0, idHits = 0;
+    start = mach_absolute_time();
+    for (unsigned i = 0; i < lookups; ++i)
+        arrayHits += [enabledApps containsObject:[queries objectAtIndex:i % appCount]] ? 1 : 0;
+    double arrayLookup = nanosecondsSince(start);
+
+    start = mach_absolute_time();
+    for (unsigned i = 0; i < lookups; ++i)
+        registryHits += appHasState([queries objectAtIndex:i % appCount], BGAppStateBackgroundingEnabled) ? 1 : 0;
+    double registryLookup = nanosecondsSince(start);
+
+    // NOTE: App IDs are kept by callers that look up the same app repeatedly
+    BGAppID *appIds = (BGAppID *)malloc(appCount * sizeof(BGAppID));
+    for (unsigned i = 0; i < appCount; ++i)
+        appIds[i] = appIdForDisplayIdentifier([queries objectAtIndex:i]);
+    start = mach_absolute_time();
+    for (unsigned i = 0; i < lookups; ++i)
+        idHits += appIdHasState(appIds[i % appCount], BGAppStateBackgroundingEnabled) ? 1 : 0;
+    double idLookup = nanosecondsSince(start);
+
+    printf("  contains, array:                %10.1f\n", arrayLookup / lookups);
+    printf("  contains, registry:             %10.1f\n", registryLookup / lookups);
+    printf("  contains, registry (app ID):    %10.1f\n", idLookup / lookups);
+
+    // Recency: move the used app to the front, as when switching apps
+    NSMutableArray *recentApps = [[NSMutableArray alloc] initWithArray:identifiers];
+    start = mach_absolute_time();
+    for (unsigned i = 0; i < lookups; ++i) {
+        NSString *identifier = [queries objectAtIndex:(i * 7) % appCount];
+        [recentApps removeObject:identifier];
+        [recentApps insertObject:identifier atIndex:0];
+    }
+    double arrayRecency = nanosecondsSince(start);
+
+    for (unsigned i = 0; i < appCount; ++i)
+        moveAppIdToFront(internDisplayIdentifier([identifiers objectAtIndex:i]));
+    start = mach_absolute_time();
+    for (unsigned i = 0; i < lookups; ++i)
+        moveAppIdToFront(appIdForDisplayIdentifier([queries objectAtIndex:(i * 7) % appCount]));
+    double registryRecency = nanosecondsSince(start);
+
+    printf("  move to front, array:           %10.1f\n", arrayRecency / lookups);
+    printf("  move to front, registry:        %10.1f\n", registryRecency / lookups);
+
+    // Both must agree on membership and on the least recently used app
+    int ret = 0;
+    if (arrayHits != registryHits || arrayHits != idHits) {
+        fprintf(stderr, "ERROR: Membership differs (%u, %u, %u)\n", arrayHits, registryHits, idHits);
+        ret = 1;
+    }
+    if (![[recentApps lastObject] isEqualToString:displayIdentifierForAppId(leastRecentAppId())]) {
+        fprintf(stderr, "ERROR: Least recently used app differs\n");
+        ret = 1;
+    }
+
+    free(appIds);
+    [recentApps release];
+    [enabledApps release];
+    [queries release];
+    [identifiers release];
+
+    [pool drain];
+    return ret;
+}
+
+/* vim: set filetype=objcpp sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */
@@ -0,0 +1,113 @@
+/**
+ * Name: Backgrounder
+ * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
+ * Description: allow applications to run in the background
+ * Author: Lance Fetters (aka. ashikase)
+ * Last-modified: 2026-10-17 12:05:31
+ */
+
+/**
+ * Copyright (C) 2008-2010  Lance Fetters (aka. ashikase)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+// Convert the Markdown documentation in the given (staging) directory to
+// final, minified HTML, so that no conversion is needed on the device.
+//
+// Usage: node render_docs.js <doc directory>
+//
+// NOTE: Each foo.mdwn is replaced by foo.html; style.css is inlined into each
+//       page and then removed.
+
+var fs = require('fs');
+var path = require('path');
+var vm = require('vm');
+
+// Load the same converter that was previously used on the device
+var context = {};
+vm.runInNewContext(fs.readFileSync(path.join(__dirname, 'showdown.js'), 'utf8'), context);
+var converter = new context.Showdown.converter();
+
+var template = fs.readFileSync(path.join(__dirname, 'doc_template.html'), 'utf8');
+
+// Block-level tags; whitespace adjacent to these does not affect rendering
+var blockTags = /\s*(<\/?(?:html|head|body|title|meta|link|style|p|div|h[1-6]|hr|br|blockquote|ul|ol|li|table|thead|tbody|tr|th|td)\b[^>]*>)\s*/gi;
+
+function minifyHtml(html)
+{
+    // NOTE: Whitespace inside <pre> blocks is significant and left untouched.
+    return html.split(/(<pre[\s\S]*?<\/pre>)/i).map(function(part) {
+        if (/^<pre/i.test(part))
+            return part;
+        return part.replace(/\s+/g, ' ').replace(blockTags, '$1');
+    }).join('').trim();
+}
+
+function minifyCss(css)
+{
+    return css.replace(/\/\*[\s\S]*?\*\//g, '')
+        .replace(/\s+/g, ' ')
+        .replace(/\s*([{}:;,>])\s*/g, '$1')
+        .replace(/;}/g, '}')
+        .trim();
+}
+
+var docDir = process.argv[2];
+if (docDir === undefined) {
+    console.error('Usage: node render_docs.js <doc directory>');
+    process.exit(1);
+}
+
+var cssPath = path.join(docDir, 'style.css');
+var style = fs.existsSync(cssPath) ? minifyCss(fs.readFileSync(cssPath, 'utf8')) : '';
+
+fs.readdirSync(docDir).forEach(function(name) {
+    if (path.extname(name) !== '.mdwn')
+        return;
+
+    var source = path.join(docDir, name);
+    var body = converter.makeHtml(fs.readFileSync(source, 'utf8'));
+
+    // NOTE: Functions are used as replacements so that '$' in the content is
+    //       not interpreted.
+    var html = template
+        .replace('<STYLE>', function() { return style; })
+        .replace('<PLACEHOLDER>', function() { return body; });
+
+    fs.writeFileSync(path.join(docDir, path.basename(name, '.mdwn') + '.html'), minifyHtml(html));
+    fs.unlinkSync(source);
+});
+
+if (fs.existsSync(cssPath))
+    fs.unlinkSync(cssPath);
+
+/* vim: set filetype=javascript sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */
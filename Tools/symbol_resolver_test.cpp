@@ -0,0 +1,322 @@
+/**
+ * Name: Backgrounder
+ * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
+ * Description: allow applications to run in the background
+ * Author: Lance Fetters (aka. ashikase)
+ * Last-modified: 2026-10-17 22:55:55
+ */
+
+/**
+ * Copyright (C) 2008-2010  Lance Fetters (aka. ashikase)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+// Check the symbol resolver against generated Mach-O fixtures
+// NOTE: Host tool; build on Linux with:
+//         c++ -O2 -Icompat -I../Extension -o symbol_resolver_test
+//             symbol_resolver_test.cpp -x c++ ../Extension/SymbolResolver.mm
+//       Usage: symbol_resolver_test
+// NOTE: Fixtures are written to temporary files, as the resolver takes a path.
+//       Besides well-formed thin and universal images, every fixture is also
+//       checked truncated at each possible length, and malformed images with
+//       out-of-range counts and offsets must resolve nothing (and not crash).
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include <libkern/OSByteOrder.h>
+#include <mach-o/arch.h>
+#include <mach-o/fat.h>
+#include <mach-o/loader.h>
+#include <mach-o/nlist.h>
+
+#include "SymbolResolver.h"
+
+// The "local" host is an ARMv7 device
+static const NXArchInfo localArchInfo_ = {"armv7", CPU_TYPE_ARM, CPU_SUBTYPE_ARM_V7, 0, "arm v7"};
+
+const NXArchInfo *NXGetLocalArchInfo(void)
+{
+    return &localArchInfo_;
+}
+
+// NOTE: Prefers an exact match of subtype; otherwise the first of the type.
+struct fat_arch *NXFindBestFatArch(cpu_type_t cputype, cpu_subtype_t cpusubtype,
+    struct fat_arch *fat_archs, uint32_t nfat_archs)
+{
+    struct fat_arch *best = NULL;
+    for (uint32_t i = 0; i < nfat_archs; ++i) {
+        if (fat_archs[i].cputype != cputype)
+            continue;
+        if (fat_archs[i].cpusubtype == cpusubtype)
+            return &fat_archs[i];
+        if (best == NULL)
+            best = &fat_archs[i];
+    }
+    return best;
+}
+
+//==============================================================================
+
+typedef std::vector<uint8_t> Buffer;
+
+struct Symbol {
+    const char *name;
+    uint8_t type;
+    int16_t desc;
+    uint32_t value;
+};
+
+template <typename Type_>
+static inline Type_ *at(Buffer &buffer, size_t offset)
+{
+    return reinterpret_cast<Type_ *>(&buffer[offset]);
+}
+
+// Layout: header, symtab command, symbols, strings
+static Buffer createImage(cpu_subtype_t cpusubtype, const std::vector<Symbol> &symbols)
+{
+    std::string strings(1, '\0');
+    std::vector<uint32_t> offsets;
+    for (size_t i = 0; i < symbols.size(); ++i) {
+        offsets.push_back(strings.size());
+        strings.append(symbols[i].name);
+        strings.push_back('\0');
+    }
+
+    size_t symoff = sizeof(struct mach_header) + sizeof(struct symtab_command);
+    size_t stroff = symoff + symbols.size() * sizeof(struct nlist);
+    Buffer image(stroff + strings.size());
+
+    struct mach_header *mh = at<struct mach_header>(image, 0);
+    mh->magic = MH_MAGIC;
+    mh->cputype = CPU_TYPE_ARM;
+    mh->cpusubtype = cpusubtype;
+    mh->filetype = MH_DYLIB;
+    mh->ncmds = 1;
+    mh->sizeofcmds = sizeof(struct symtab_command);
+
+    struct symtab_command *symtab = at<struct symtab_command>(image, sizeof(struct mach_header));
+    symtab->cmd = LC_SYMTAB;
+    symtab->cmdsize = sizeof(struct symtab_command);
+    symtab->symoff = symoff;
+    symtab->nsyms = symbols.size();
+    symtab->stroff = stroff;
+    symtab->strsize = strings.size();
+
+    for (size_t i = 0; i < symbols.size(); ++i) {
+        struct nlist *nl = at<struct nlist>(image, symoff + i * sizeof(struct nlist));
+        nl->n_un.n_strx = offsets[i];
+        nl->n_type = symbols[i].type;
+        nl->n_sect = 1;
+        nl->n_desc = symbols[i].desc;
+        nl->n_value = symbols[i].value;
+    }
+    memcpy(&image[stroff], strings.data(), strings.size());
+    return image;
+}
+
+static Buffer createUniversal(const std::vector<std::pair<cpu_subtype_t, Buffer> > &slices)
+{
+    const uint32_t align = 12;
+    size_t offset = sizeof(struct fat_header) + slices.size() * sizeof(struct fat_arch);
+    Buffer universal(offset);
+    struct fat_header *fh = at<struct fat_header>(universal, 0);
+    fh->magic = OSSwapHostToBigInt32(FAT_MAGIC);
+    fh->nfat_arch = OSSwapHostToBigInt32(slices.size());
+
+    for (size_t i = 0; i < slices.size(); ++i) {
+        offset = (offset + (1 << align) - 1) & ~((1 << align) - 1);
+        struct fat_arch *arch = at<struct fat_arch>(universal,
+            sizeof(struct fat_header) + i * sizeof(struct fat_arch));
+        arch->cputype = OSSwapHostToBigInt32(CPU_TYPE_ARM);
+        arch->cpusubtype = OSSwapHostToBigInt32(slices[i].first);
+        arch->offset = OSSwapHostToBigInt32(offset);
+        arch->size = OSSwapHostToBigInt32(slices[i].second.size());
+        arch->align = OSSwapHostToBigInt32(align);
+
+        universal.resize(offset);
+        universal.insert(universal.end(), slices[i].second.begin(), slices[i].second.end());
+        offset = universal.size();
+    }
+    return universal;
+}
+
+//==============================================================================
+
+static char path_[] = "/tmp/symbol_resolver_test.XXXXXX";
+static unsigned int failures_ = 0;
+
+static uintptr_t lookup(const Buffer &file, const char *symbolName)
+{
+    FILE *f = fopen(path_, "wb");
+    if (f == NULL || (!file.empty() && fwrite(&file[0], 1, file.size(), f) != file.size())) {
+        perror(path_);
+        exit(1);
+    }
+    fclose(f);
+    return lookupSymbolAddress(path_, symbolName);
+}
+
+static void expect(const char *test, const Buffer &file, const char *symbolName, uintptr_t expected)
+{
+    uintptr_t address = lookup(file, symbolName);
+    if (address != expected) {
+        printf("FAIL %s: %s resolved to 0x%lx, expected 0x%lx\n", test, symbolName,
+            (unsigned long)address, (unsigned long)expected);
+        ++failures_;
+    }
+}
+
+// Every truncated copy must either resolve correctly or not at all
+static void expectTruncated(const char *test, const Buffer &file, const char *symbolName, uintptr_t expected)
+{
+    for (size_t length = 0; length < file.size(); ++length) {
+        Buffer truncated(file.begin(), file.begin() + length);
+        uintptr_t address = lookup(truncated, symbolName);
+        if (address != 0 && address != expected) {
+            printf("FAIL %s: truncated to %lu bytes, %s resolved to 0x%lx\n", test,
+                (unsigned long)length, symbolName, (unsigned long)address);
+            ++failures_;
+            return;
+        }
+    }
+}
+
+static std::vector<Symbol> uikitSymbols(uint32_t base)
+{
+    Symbol symbols[] = {
+        {"_UIApplicationMain", N_SECT | N_EXT, N_ARM_THUMB_DEF, base + 0x100},
+        {"__backgroundTasks", N_SECT, 0, base + 0x200},
+        {"_objc_msgSend", N_UNDF | N_EXT, 0, 0},
+        {"debug.c", 0x64 /* N_SO */, 0, base + 0x300},
+        {"_UIApplicationMainLater", N_SECT | N_EXT, 0, base + 0x400}
+    };
+    return std::vector<Symbol>(symbols, symbols + sizeof(symbols) / sizeof(symbols[0]));
+}
+
+int main()
+{
+    int fd = mkstemp(path_);
+    if (fd == -1) {
+        perror("mkstemp");
+        return 1;
+    }
+    close(fd);
+
+    // Thin image
+    Buffer thin = createImage(CPU_SUBTYPE_ARM_V7, uikitSymbols(0x1000));
+    expect("thin", thin, "__backgroundTasks", 0x1200);
+    expect("thin", thin, "_UIApplicationMain", 0x1101);
+    expect("thin", thin, "_UIApplicationMainLater", 0x1400);
+    expect("thin", thin, "_UIApplication", 0);
+    expect("thin (undefined)", thin, "_objc_msgSend", 0);
+    expect("thin (debug)", thin, "debug.c", 0);
+    expectTruncated("thin", thin, "_UIApplicationMainLater", 0x1400);
+
+    // Universal image; the ARMv7 slice must be chosen
+    std::vector<std::pair<cpu_subtype_t, Buffer> > slices;
+    slices.push_back(std::make_pair(CPU_SUBTYPE_ARM_V6, createImage(CPU_SUBTYPE_ARM_V6, uikitSymbols(0x5000))));
+    slices.push_back(std::make_pair(CPU_SUBTYPE_ARM_V7, createImage(CPU_SUBTYPE_ARM_V7, uikitSymbols(0x9000))));
+    Buffer universal = createUniversal(slices);
+    expect("universal", universal, "__backgroundTasks", 0x9200);
+    expectTruncated("universal", universal, "__backgroundTasks", 0x9200);
+
+    size_t symtabOffset = sizeof(struct mach_header);
+    Buffer bad;
+
+    // Symbol count whose size in bytes overflows 32 bits
+    bad = thin;
+    at<struct symtab_command>(bad, symtabOffset)->nsyms = 0x15555556;
+    expect("nsyms overflow", bad, "__backgroundTasks", 0);
+
+    // Tables outside of the file
+    bad = thin;
+    at<struct symtab_command>(bad, symtabOffset)->symoff = 0xfffffff0;
+    expect("symoff", bad, "__backgroundTasks", 0);
+    bad = thin;
+    at<struct symtab_command>(bad, symtabOffset)->stroff = bad.size() + 1;
+    expect("stroff", bad, "__backgroundTasks", 0);
+    bad = thin;
+    at<struct symtab_command>(bad, symtabOffset)->strsize = 0xffffffff;
+    expect("strsize", bad, "__backgroundTasks", 0);
+
+    // String index past the string table
+    bad = thin;
+    at<struct nlist>(bad, at<struct symtab_command>(bad, symtabOffset)->symoff + sizeof(struct nlist))->n_un.n_strx = 0x7fffffff;
+    expect("n_strx", bad, "__backgroundTasks", 0);
+    expect("n_strx (other symbol)", bad, "_UIApplicationMain", 0x1101);
+
+    // Name not terminated within the string table
+    bad = thin;
+    at<struct symtab_command>(bad, symtabOffset)->strsize -= 1;
+    expect("unterminated", bad, "_UIApplicationMainLater", 0);
+
+    // Load commands of invalid size, or too many of them
+    bad = thin;
+    at<struct symtab_command>(bad, symtabOffset)->cmdsize = 0;
+    expect("cmdsize 0", bad, "__backgroundTasks", 0);
+    bad = thin;
+    at<struct symtab_command>(bad, symtabOffset)->cmdsize = 0xfffffff0;
+    expect("cmdsize", bad, "__backgroundTasks", 0);
+    bad = thin;
+    at<struct symtab_command>(bad, symtabOffset)->cmd = 0x1;
+    at<struct mach_header>(bad, 0)->ncmds = 0xffffffff;
+    expect("ncmds", bad, "__backgroundTasks", 0);
+
+    // Universal headers out of range
+    bad = universal;
+    at<struct fat_header>(bad, 0)->nfat_arch = OSSwapHostToBigInt32(0x40000000);
+    expect("nfat_arch", bad, "__backgroundTasks", 0);
+    bad = universal;
+    at<struct fat_arch>(bad, sizeof(struct fat_header) + sizeof(struct fat_arch))->size = OSSwapHostToBigInt32(0xfffff000);
+    expect("fat size", bad, "__backgroundTasks", 0);
+
+    // Missing or empty file
+    expect("empty", Buffer(), "__backgroundTasks", 0);
+    unlink(path_);
+    if (lookupSymbolAddress(path_, "__backgroundTasks") != 0) {
+        printf("FAIL missing file\n");
+        ++failures_;
+    }
+
+    printf(failures_ == 0 ? "PASSED\n" : "FAILED\n");
+    return (failures_ == 0) ? 0 : 1;
+}
+
+/* vim: set filetype=cpp sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */
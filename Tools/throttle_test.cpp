@@ -0,0 +1,296 @@
+/**
+ * Name: Backgrounder
+ * Type: iPhone OS SpringBoard extension (MobileSubstrate-based)
+ * Description: allow applications to run in the background
+ * Author: Lance Fetters (aka. ashikase)
+ * Last-modified: 2026-10-17 22:43:38
+ */
+
+/**
+ * Copyright (C) 2008-2010  Lance Fetters (aka. ashikase)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * 3. The name of the author may not be used to endorse or promote
+ *    products derived from this software without specific prior
+ *    written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+// Check the throttle scheduler against real child processes
+// NOTE: Host tool (Linux only, as process states are read from /proc); build
+//       with:
+//         c++ -O2 -I../Extension -o throttle_test throttle_test.cpp
+//             -x c++ ../Extension/ThrottleScheduler.mm
+//       Usage: throttle_test [-a <apps>] [-d <seconds>] [-r <run>] [-p <period>]
+// NOTE: Each child counts the milliseconds it spends running; compared with
+//       an unthrottled child, this gives the duty cycle actually achieved.
+//       The scheduler is driven with CLOCK_MONOTONIC, as on device.
+
+#include <errno.h>
+#include <math.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <vector>
+
+#include "ThrottleScheduler.h"
+
+static double currentTime()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1.0e9;
+}
+
+static void sleepUntil(double time)
+{
+    double interval = time - currentTime();
+    if (interval <= 0)
+        return;
+
+    struct timespec ts;
+    ts.tv_sec = (time_t)interval;
+    ts.tv_nsec = (long)((interval - ts.tv_sec) * 1.0e9);
+    while (nanosleep(&ts, &ts) == -1 && errno == EINTR);
+}
+
+// Returns the state letter from /proc (e.g. 'T' if stopped), or 0 if gone
+static char processState(pid_t pid)
+{
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%d/stat", pid);
+    FILE *f = fopen(path, "r");
+    if (f == NULL)
+        return 0;
+
+    char state = 0;
+    if (fscanf(f, "%*d (%*[^)]) %c", &state) != 1)
+        state = 0;
+    fclose(f);
+    return state;
+}
+
+// NOTE: Counters live in memory shared with the children.
+static volatile uint32_t *ticks_ = NULL;
+
+static pid_t spawnApplication(unsigned int index)
+{
+    pid_t pid = fork();
+    if (pid == 0) {
+        // Count milliseconds spent running (sleeping counts as running)
+        struct timespec ts = {0, 1000000};
+        for (;;) {
+            nanosleep(&ts, NULL);
+            ticks_[index] = ticks_[index] + 1;
+        }
+    }
+    return pid;
+}
+
+static unsigned int failures_ = 0;
+
+static void check(bool condition, const char *description)
+{
+    printf("%-4s %s\n", condition ? "ok" : "FAIL", description);
+    if (!condition)
+        ++failures_;
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+        "Usage: %s [options]\n"
+        "Options:\n"
+        "  -a <apps>     number of throttled apps (default: 4)\n"
+        "  -d <seconds>  duration of the run (default: 3)\n"
+        "  -r <seconds>  run duration of each period (default: 0.1)\n"
+        "  -p <seconds>  throttle period (default: 0.5)\n", name);
+}
+
+int main(int argc, char **argv)
+{
+    unsigned int appCount = 4;
+    double duration = 3.0;
+    double runDuration = 0.1;
+    double period = 0.5;
+
+    int c;
+    while ((c = getopt(argc, argv, "a:d:r:p:")) != -1) {
+        switch (c) {
+            case 'a':
+                appCount = strtoul(optarg, NULL, 10);
+                break;
+            case 'd':
+                duration = atof(optarg);
+                break;
+            case 'r':
+                runDuration = atof(optarg);
+                break;
+            case 'p':
+                period = atof(optarg);
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (appCount == 0 || duration <= 0 || runDuration <= 0 || period <= runDuration) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    // NOTE: The last counter belongs to the unthrottled control app.
+    void *addr = mmap(NULL, (appCount + 1) * sizeof(uint32_t), PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_ANON, -1, 0);
+    if (addr == MAP_FAILED) {
+        perror("mmap");
+        return 1;
+    }
+    ticks_ = reinterpret_cast<volatile uint32_t *>(addr);
+
+    std::vector<pid_t> pids;
+    for (unsigned int i = 0; i <= appCount; ++i) {
+        pid_t pid = spawnApplication(i);
+        if (pid < 0) {
+            perror("fork");
+            break;
+        }
+        pids.push_back(pid);
+    }
+    if (pids.size() != appCount + 1) {
+        for (size_t i = 0; i < pids.size(); ++i)
+            kill(pids[i], SIGKILL);
+        return 1;
+    }
+    pid_t control = pids.back();
+    pids.pop_back();
+
+    ThrottleScheduler *scheduler = new ThrottleScheduler();
+
+    // Add the apps at staggered times, as they would be backgrounded
+    double start = currentTime();
+    for (size_t i = 0; i < pids.size(); ++i) {
+        scheduler->add(pids[i], runDuration, period, currentTime());
+        sleepUntil(currentTime() + period / (2 * pids.size()));
+    }
+    double throttleStart = currentTime();
+    for (unsigned int i = 0; i <= appCount; ++i)
+        ticks_[i] = 0;
+
+    // Drive the scheduler, sampling the process states along the way
+    unsigned int fires = 0, signalled = 0;
+    unsigned long samples = 0, stoppedSamples = 0;
+    double end = throttleStart + duration;
+    while (currentTime() < end) {
+        double fireTime = scheduler->nextFireTime();
+        double sampleTime = currentTime() + 0.01;
+        if (fireTime >= 0 && fireTime <= sampleTime) {
+            sleepUntil(fireTime);
+            signalled += scheduler->fire(currentTime());
+            ++fires;
+        } else {
+            sleepUntil(sampleTime);
+            for (size_t i = 0; i < pids.size(); ++i) {
+                ++samples;
+                if (processState(pids[i]) == 'T')
+                    ++stoppedSamples;
+            }
+        }
+    }
+    double elapsed = currentTime() - throttleStart;
+
+    double expected = runDuration / period;
+    double controlTicks = ticks_[appCount];
+    printf("Apps: %u, run %.3fs of every %.3fs for %.1fs (setup %.2fs)\n",
+        appCount, runDuration, period, elapsed, throttleStart - start);
+    printf("Timer fires: %u (%.1f per period), signals sent: %u\n",
+        fires, fires * period / elapsed, signalled);
+    printf("Expected duty cycle: %.2f\n", expected);
+    bool dutyCyclesMatch = (controlTicks > 0);
+    for (size_t i = 0; i < pids.size(); ++i) {
+        double achieved = ticks_[i] / controlTicks;
+        printf("  [%d] duty cycle %.2f\n", pids[i], achieved);
+        if (fabs(achieved - expected) > 0.1)
+            dutyCyclesMatch = false;
+    }
+    printf("Stopped in %.0f%% of samples\n", samples ? 100.0 * stoppedSamples / samples : 0.0);
+
+    check(dutyCyclesMatch, "duty cycle of each app is within 0.1 of expected");
+    check(samples != 0 && fabs((double)stoppedSamples / samples - (1.0 - expected)) < 0.15,
+        "apps are stopped for the rest of each period");
+    // NOTE: Apps share the resume grid, so each period needs at most one wakeup
+    //       to resume all apps, plus one per app to stop them.
+    check(fires * period / elapsed <= pids.size() + 1.5, "wakeups are coalesced");
+
+    // A stopped app that is added again must be resumed
+    pid_t first = pids[0];
+    while (!scheduler->isStopped(first)) {
+        sleepUntil(scheduler->nextFireTime());
+        scheduler->fire(currentTime());
+    }
+    scheduler->add(first, runDuration, period, currentTime());
+    usleep(20000);
+    check(processState(first) != 'T', "re-added app is resumed");
+
+    // An app that has exited is dropped
+    pid_t last = pids.back();
+    kill(last, SIGKILL);
+    waitpid(last, NULL, 0);
+    pids.pop_back();
+    double deadline = currentTime() + 2 * period;
+    while (scheduler->contains(last) && currentTime() < deadline) {
+        sleepUntil(scheduler->nextFireTime());
+        scheduler->fire(currentTime());
+    }
+    check(!scheduler->contains(last), "exited app is dropped");
+
+    // No app may be left stopped once throttling ends
+    delete scheduler;
+    usleep(20000);
+    bool allRunning = true;
+    for (size_t i = 0; i < pids.size(); ++i)
+        if (processState(pids[i]) == 'T')
+            allRunning = false;
+    check(allRunning, "all apps are resumed when throttling ends");
+
+    pids.push_back(control);
+    for (size_t i = 0; i < pids.size(); ++i) {
+        kill(pids[i], SIGKILL);
+        waitpid(pids[i], NULL, 0);
+    }
+
+    printf(failures_ == 0 ? "PASSED\n" : "FAILED\n");
+    return (failures_ == 0) ? 0 : 1;
+}
+
+/* vim: set filetype=cpp sw=4 ts=4 sts=4 expandtab textwidth=80 ff=unix: */